@@ -52,7 +52,7 @@ void __weak board_init_f(ulong dummy)
  */
 #if CONFIG_IS_ENABLED(OS_BOOT)
 #ifdef CONFIG_ARM64
-void __noreturn jump_to_image_linux(struct spl_image_info *spl_image)
+void __weak __noreturn jump_to_image_linux(struct spl_image_info *spl_image)
 {
 	debug("Entering kernel arg pointer: 0x%p\n", spl_image->arg);
 	cleanup_before_linux();
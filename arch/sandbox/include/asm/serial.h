@@ -20,11 +20,19 @@ struct sandbox_serial_plat {
  * struct sandbox_serial_priv - Private data for this driver
  *
  * @buf: holds input characters available to be read by this driver
+ * @tx_full: true to refuse output as if the TX FIFO was full
+ * @tx_buf: buffer for output captured by a test, NULL if not capturing
+ * @tx_size: size of @tx_buf
+ * @tx_len: number of characters in @tx_buf
  */
 struct sandbox_serial_priv {
 	struct membuff buf;
 	char serial_buf[16];
 	bool start_of_line;
+	bool tx_full;
+	char *tx_buf;
+	int tx_size;
+	int tx_len;
 };
 
 #endif /* __asm_serial_h */
@@ -269,6 +269,27 @@ uint sandbox_pci_read_bar(u32 barval, int type, uint size);
  */
 void sandbox_set_enable_memio(bool enable);
 
+/**
+ * sandbox_serial_set_tx_full() - Make a serial port refuse output
+ *
+ * @dev: Sandbox serial device
+ * @full: true to make putc() return -EAGAIN as if the TX FIFO was full,
+ *	false to accept output again
+ */
+void sandbox_serial_set_tx_full(struct udevice *dev, bool full);
+
+/**
+ * sandbox_serial_capture_tx() - Capture the output of a serial port
+ *
+ * While capturing, output goes to @buf instead of stdout. Output which does
+ * not fit is dropped.
+ *
+ * @dev: Sandbox serial device
+ * @buf: Buffer for the output, kept NUL-terminated, or NULL to stop
+ * @size: Size of @buf
+ */
+void sandbox_serial_capture_tx(struct udevice *dev, char *buf, int size);
+
 /**
  * sandbox_cros_ec_set_test_flags() - Set behaviour for testing purposes
  *
@@ -15,6 +15,7 @@
 #include <asm/bootm.h>
 #include <asm/cache.h>
 #include <asm/setup.h>
+#include <linux/err.h>
 #include "karo.h"
 
 static void karo_set_fdtsize(void *fdt)
@@ -52,8 +53,8 @@ static char *karo_fdt_overlay_filename(const char *prefix,
 
 static bool fdt_overlay_debug = IS_ENABLED(CONFIG_DEBUG);
 
-int karo_load_fdt_overlay(void *fdt, const char *dev_type, const char *dev_part,
-			  const char *overlay)
+static void *karo_read_fdt_overlay(const char *dev_type, const char *dev_part,
+				   const char *overlay)
 {
 	int ret;
 	loff_t size;
@@ -63,13 +64,13 @@ int karo_load_fdt_overlay(void *fdt, const char *dev_type, const char *dev_part,
 	char *filename = karo_fdt_overlay_filename(soc_family, overlay);
 
 	if (!filename)
-		return -ENOMEM;
+		return ERR_PTR(-ENOMEM);
 
 	if (!file_exists(dev_type, dev_part, filename, FS_TYPE_ANY)) {
 		free(filename);
 		filename = karo_fdt_overlay_filename(soc_prefix, overlay);
 		if (!filename)
-			return -ENOMEM;
+			return ERR_PTR(-ENOMEM);
 	}
 	if (fdt_overlay_debug)
 		printf("loading FDT overlay for '%s' from %s %s '%s'\n",
@@ -77,18 +78,19 @@ int karo_load_fdt_overlay(void *fdt, const char *dev_type, const char *dev_part,
 
 	if (!file_exists(dev_type, dev_part, filename, FS_TYPE_ANY)) {
 		printf("'%s' does not exist\n", filename);
-		ret = -ENOENT;
+		fdto = ERR_PTR(-ENOENT);
 		goto free_fn;
 	}
 
 	if (fs_set_blk_dev(dev_type, dev_part, FS_TYPE_ANY)) {
-		ret = -ENOENT;
+		fdto = ERR_PTR(-ENOENT);
 		goto free_fn;
 	}
 
 	ret = fs_size(filename, &size);
 	if (ret) {
 		printf("Failed to get size of '%s': %d\n", filename, errno);
+		fdto = ERR_PTR(ret);
 		goto free_fn;
 	}
 
@@ -96,7 +98,7 @@ int karo_load_fdt_overlay(void *fdt, const char *dev_type, const char *dev_part,
 	if (!fdto) {
 		printf("%s@%d: failed to allocate %llu bytes for '%s'\n",
 		       __func__, __LINE__, size, filename);
-		ret = -ENOMEM;
+		fdto = ERR_PTR(-ENOMEM);
 		goto free_fn;
 	}
 
@@ -113,20 +115,61 @@ int karo_load_fdt_overlay(void *fdt, const char *dev_type, const char *dev_part,
 		goto free_buf;
 
 	debug("Read %llu byte from '%s'\n", size, filename);
-	fdt_shrink_to_minimum(fdt, size);
-	ret = fdt_overlay_apply_verbose(fdt, fdto);
-	if (ret) {
-		printf("Failed to load FDT overlay from '%s': %s\n",
-		       filename, fdt_strerror(ret));
-		memset(fdt, 0, sizeof(struct fdt_header));
+	if (fdt_check_header(fdto) || fdt_totalsize(fdto) > size) {
+		printf("'%s' is not a valid FDT overlay\n", filename);
 		ret = -EINVAL;
+		goto free_buf;
 	}
+	free(filename);
+	return fdto;
 
  free_buf:
 	free(fdto);
+	fdto = ERR_PTR(ret);
 
  free_fn:
-	free((void *)filename);
+	free(filename);
+	return fdto;
+}
+
+static int karo_apply_fdt_overlays(void *fdt, void **fdtos,
+				   const char **names, int count)
+{
+	size_t size = 0;
+	int ret;
+	int i;
+
+	/* Make room for all overlays at once instead of for each of them */
+	for (i = 0; i < count; i++)
+		size += fdt_totalsize(fdtos[i]);
+	fdt_shrink_to_minimum(fdt, size);
+
+	for (i = 0; i < count; i++) {
+		ret = fdt_overlay_apply_verbose(fdt, fdtos[i]);
+		if (ret) {
+			printf("Failed to load FDT overlay '%s': %s\n",
+			       names[i], fdt_strerror(ret));
+			memset(fdt, 0, sizeof(struct fdt_header));
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+int karo_load_fdt_overlay(void *fdt, const char *dev_type, const char *dev_part,
+			  const char *overlay)
+{
+	void *fdto;
+	int ret;
+
+	fdto = karo_read_fdt_overlay(dev_type, dev_part, overlay);
+	if (IS_ERR(fdto))
+		return PTR_ERR(fdto);
+
+	ret = karo_apply_fdt_overlays(fdt, &fdto, &overlay, 1);
+	free(fdto);
+
 	return ret;
 }
 
@@ -171,21 +214,44 @@ void karo_fdt_apply_overlays(unsigned long fdt_addr)
 	if (ret == 0 && overlays) {
 		char *overlay_list = strdup(overlays);
 		const char *overlay_listp = overlay_list;
+		/* a list of n overlays has at least n - 1 separators */
+		int max = strlen(overlays) / 2 + 1;
+		const char **names = calloc(max, sizeof(*names));
+		void **fdtos = calloc(max, sizeof(*fdtos));
 		char *overlay;
+		int count = 0;
+
+		if (!overlay_list || !names || !fdtos) {
+			ret = -ENOMEM;
+			goto free_list;
+		}
 
 		debug("loading FDT overlays for '%s': %s\n",
 		      baseboard, overlays);
 		while ((overlay = strsep(&overlay_list, ", "))) {
+			void *fdto;
+
 			if (!strlen(overlay))
 				continue;
-			ret = karo_load_fdt_overlay((void *)fdt_addr, dev_type,
-						    dev_part, overlay);
-			if (ret) {
+			fdto = karo_read_fdt_overlay(dev_type, dev_part,
+						     overlay);
+			if (IS_ERR(fdto)) {
+				ret = PTR_ERR(fdto);
 				printf("Failed to load FDT overlay '%s': %d\n",
 				       overlay, ret);
 				break;
 			}
+			names[count] = overlay;
+			fdtos[count++] = fdto;
 		}
+		if (!ret)
+			ret = karo_apply_fdt_overlays((void *)fdt_addr, fdtos,
+						      names, count);
+		while (count--)
+			free(fdtos[count]);
+ free_list:
+		free(fdtos);
+		free(names);
 		free((void *)overlay_listp);
 	} else if (ret) {
 		printf("Failed to load FDT overlays: %d\n", ret);
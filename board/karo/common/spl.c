@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: GPL-2.0
+/*
+ * Falcon mode support for Ka-Ro i.MX8M and i.MX93 modules
+ */
+
+#include <common.h>
+#include <cpu_func.h>
+#include <env.h>
+#include <serial.h>
+#include <spl.h>
+#include <asm/gpio.h>
+
+/* where BL31 is loaded from the falcon mode FIT image */
+#if defined(CONFIG_IMX8MM)
+#define KARO_BL31_ENTRY		0x920000UL
+#elif defined(CONFIG_IMX8MN)
+#define KARO_BL31_ENTRY		0x960000UL
+#elif defined(CONFIG_IMX8MP)
+#define KARO_BL31_ENTRY		0x970000UL
+#elif defined(CONFIG_IMX93)
+#define KARO_BL31_ENTRY		0x204e0000UL
+#else
+#error Unsupported SoC
+#endif
+
+/*
+ * BL31 always starts the non-secure world at CONFIG_SYS_TEXT_BASE, without
+ * passing the DTB address the kernel expects in x0. This stub is put there
+ * in place of U-Boot to load x0..x3 and branch to the kernel.
+ */
+struct karo_falcon_stub {
+	u32 insn[6];
+	u64 fdt;
+	u64 entry;
+};
+
+static const u32 karo_falcon_insn[] = {
+	0x580000c0,	/* ldr	x0, fdt */
+	0xaa1f03e1,	/* mov	x1, xzr */
+	0xaa1f03e2,	/* mov	x2, xzr */
+	0xaa1f03e3,	/* mov	x3, xzr */
+	0x58000084,	/* ldr	x4, entry */
+	0xd61f0080,	/* br	x4 */
+};
+
+#if defined(CONFIG_KARO_SPL_FALCON_GPIO) && CONFIG_KARO_SPL_FALCON_GPIO >= 0
+static int karo_falcon_gpio_override(void)
+{
+	unsigned int gpio = CONFIG_KARO_SPL_FALCON_GPIO;
+	int ret;
+
+	ret = gpio_request(gpio, "falcon");
+	if (ret) {
+		printf("Failed to request falcon mode GPIO%u: %d\n", gpio, ret);
+		return 0;
+	}
+
+	ret = gpio_direction_input(gpio);
+	if (!ret)
+		ret = gpio_get_value(gpio);
+	gpio_free(gpio);
+
+	return ret == 0;
+}
+#else
+static inline int karo_falcon_gpio_override(void)
+{
+	return 0;
+}
+#endif
+
+/*
+ * The kernel args (DTB prepared with 'spl export fdt') and the kernel
+ * image are loaded from the raw eMMC sectors configured with
+ * CONFIG_SYS_MMCSD_RAW_MODE_ARGS_SECTOR and
+ * CONFIG_SYS_MMCSD_RAW_MODE_KERNEL_SECTOR.
+ *
+ * Return: 1 - boot to U-Boot. 0 - boot OS (falcon mode)
+ */
+int spl_start_uboot(void)
+{
+	/* break into full U-Boot on 'c' */
+	if (serial_tstc() && serial_getc() == 'c')
+		return 1;
+
+	if (karo_falcon_gpio_override())
+		return 1;
+
+#ifdef CONFIG_SPL_ENV_SUPPORT
+	if (env_init() || env_load())
+		return 1;
+
+	if (env_get_yesno("boot_os") != 1)
+		return 1;
+#endif
+	return 0;
+}
+
+/*
+ * The kernel needs BL31 for PSCI and the secure world setup, so it is not
+ * entered from SPL directly. The falcon mode FIT image loads BL31 as a
+ * loadable, which then starts the kernel through the stub above.
+ */
+void __noreturn jump_to_image_linux(struct spl_image_info *spl_image)
+{
+	struct karo_falcon_stub *stub = (void *)CONFIG_SYS_TEXT_BASE;
+	struct spl_image_info bl31 = *spl_image;
+
+	memcpy(stub->insn, karo_falcon_insn, sizeof(stub->insn));
+	stub->fdt = (uintptr_t)spl_image->arg;
+	stub->entry = spl_image->entry_point;
+
+	debug("Entering kernel at %08lx through BL31, DTB at %p\n",
+	      spl_image->entry_point, spl_image->arg);
+	cleanup_before_linux();
+
+	bl31.entry_point = KARO_BL31_ENTRY;
+	jump_to_image_no_args(&bl31);
+}
@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Command-line access to malloc() statistics
+ */
+
+#include <common.h>
+#include <command.h>
+#include <malloc.h>
+
+static int do_malloc_info(struct cmd_tbl *cmdtp, int flag, int argc,
+			  char *const argv[])
+{
+	malloc_stats();
+
+	return 0;
+}
+
+#ifdef CONFIG_SYS_LONGHELP
+static char malloc_help_text[] =
+	"info   - show malloc() heap usage and fragmentation";
+#endif
+
+U_BOOT_CMD_WITH_SUBCMDS(malloc, "malloc information", malloc_help_text,
+	U_BOOT_SUBCMD_MKENT(info, 1, 1, do_malloc_info));
@@ -224,6 +224,36 @@ uint32_t bootstage_accum(enum bootstage_id id)
 	return duration;
 }
 
+uint32_t bootstage_add_accum(const char *name, uint32_t start_us)
+{
+	struct bootstage_data *data = gd->bootstage;
+	struct bootstage_record *rec;
+	struct bootstage_record *end;
+	uint32_t duration = (uint32_t)timer_get_boot_us() - start_us;
+
+	if (!data)
+		return duration;
+
+	/* Add to an earlier accumulator record of the same name */
+	for (rec = data->record, end = rec + data->rec_count; rec < end;
+	     rec++) {
+		if (rec->start_us && rec->name && !strcmp(rec->name, name)) {
+			rec->time_us += duration;
+			return duration;
+		}
+	}
+
+	rec = ensure_id(data, data->next_id++);
+	if (rec) {
+		rec->start_us = start_us;
+		rec->time_us = duration;
+		/* The caller's name may go away, e.g. on device unbind */
+		rec->name = strdup(name);
+	}
+
+	return duration;
+}
+
 /**
  * Get a record name as a printable string
  *
@@ -9,6 +9,7 @@
  */
 
 #include <common.h>
+#include <bootstage.h>
 #include <compiler.h>
 #include <command.h>
 #include <console.h>
@@ -575,11 +576,26 @@ int cmd_discard_repeatable(struct cmd_tbl *cmdtp, int flag, int argc,
 static int cmd_call(struct cmd_tbl *cmdtp, int flag, int argc,
 		    char *const argv[], int *repeatable)
 {
+	__maybe_unused uint32_t start_us = 0;
 	int result;
 
+	if (IS_ENABLED(CONFIG_BOOTSTAGE_CMD))
+		start_us = timer_get_boot_us();
+
 	result = cmdtp->cmd_rep(cmdtp, flag, argc, argv, repeatable);
 	if (result)
 		debug("Command failed, result=%d\n", result);
+
+#ifdef CONFIG_BOOTSTAGE_CMD
+	if ((uint32_t)timer_get_boot_us() - start_us >=
+	    CONFIG_BOOTSTAGE_CMD_MIN_US) {
+		char name[32];
+
+		snprintf(name, sizeof(name), "cmd:%s", cmdtp->name);
+		bootstage_add_accum(name, start_us);
+	}
+#endif
+
 	return result;
 }
 
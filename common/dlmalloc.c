@@ -16,10 +16,14 @@
 #define DEBUG
 #endif
 
+#if defined(DEBUG) || CONFIG_IS_ENABLED(CMD_MALLOC)
+#define MALLOC_STATS
+#endif
+
 #include <malloc.h>
 #include <asm/io.h>
 
-#ifdef DEBUG
+#ifdef MALLOC_STATS
 #if __STD_C
 static void malloc_update_mallinfo (void);
 void malloc_stats (void);
@@ -27,7 +31,7 @@ void malloc_stats (void);
 static void malloc_update_mallinfo ();
 void malloc_stats();
 #endif
-#endif	/* DEBUG */
+#endif	/* MALLOC_STATS */
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -615,11 +619,37 @@ void *sbrk(ptrdiff_t increment)
 	return (void *)old;
 }
 
+#if CONFIG_IS_ENABLED(SYS_MALLOC_TCACHE)
+/*
+ * Per-size caches of recently freed small chunks, tried before the bins.
+ * Cached chunks stay marked in use, so they are neither coalesced nor found
+ * by the bin scan, and are handed out again without any bookkeeping.
+ */
+#define TCACHE_BINS	32	/* chunk sizes in units of MALLOC_ALIGNMENT */
+#define TCACHE_FILL	7	/* max. chunks kept per size */
+
+struct tcache_entry {
+	struct tcache_entry *next;
+};
+
+static struct tcache_entry *tcache[TCACHE_BINS];
+static unsigned char tcache_count[TCACHE_BINS];
+
+static void tcache_init(void)
+{
+	memset(tcache, 0, sizeof(tcache));
+	memset(tcache_count, 0, sizeof(tcache_count));
+}
+#else
+static inline void tcache_init(void) {}
+#endif
+
 void mem_malloc_init(ulong start, ulong size)
 {
 	mem_malloc_start = start;
 	mem_malloc_end = start + size;
 	mem_malloc_brk = start;
+	tcache_init();
 
 #ifdef CONFIG_SYS_MALLOC_DEFAULT_TO_INIT
 	malloc_init();
@@ -1280,6 +1310,38 @@ static void malloc_extend_top(nb) INTERNAL_SIZE_T nb;
 
 */
 
+#if CONFIG_IS_ENABLED(SYS_MALLOC_TCACHE)
+static mchunkptr tcache_get(INTERNAL_SIZE_T nb)
+{
+	unsigned long idx = nb / MALLOC_ALIGNMENT;
+	struct tcache_entry *e;
+
+	if (idx >= TCACHE_BINS || !tcache[idx])
+		return NULL;
+
+	e = tcache[idx];
+	tcache[idx] = e->next;
+	tcache_count[idx]--;
+
+	return mem2chunk(e);
+}
+
+static bool tcache_put(mchunkptr p)
+{
+	unsigned long idx = chunksize(p) / MALLOC_ALIGNMENT;
+	struct tcache_entry *e = chunk2mem(p);
+
+	if (idx >= TCACHE_BINS || tcache_count[idx] >= TCACHE_FILL)
+		return false;
+
+	e->next = tcache[idx];
+	tcache[idx] = e;
+	tcache_count[idx]++;
+
+	return true;
+}
+#endif
+
 #if __STD_C
 Void_t* mALLOc(size_t bytes)
 #else
@@ -1316,6 +1378,16 @@ Void_t* mALLOc(bytes) size_t bytes;
 
   nb = request2size(bytes);  /* padded request size; */
 
+#if CONFIG_IS_ENABLED(SYS_MALLOC_TCACHE)
+  victim = tcache_get(nb);
+  if (victim)
+  {
+    /* A cached chunk's lower neighbour may have been freed meanwhile */
+    check_inuse_chunk(victim);
+    return chunk2mem(victim);
+  }
+#endif
+
   /* Check for exact match in a bin */
 
   if (is_small_request(nb))  /* Faster version for small requests */
@@ -1591,6 +1663,11 @@ void fREe(mem) Void_t* mem;
 
   check_inuse_chunk(p);
 
+#if CONFIG_IS_ENABLED(SYS_MALLOC_TCACHE)
+  if (tcache_put(p))
+    return;
+#endif
+
   sz = hd & ~PREV_INUSE;
   next = chunk_at_offset(p, sz);
   nextsz = chunksize(next);
@@ -2302,7 +2379,10 @@ size_t malloc_usable_size(mem) Void_t* mem;
 
 /* Utility to update current_mallinfo for malloc_stats and mallinfo() */
 
-#ifdef DEBUG
+#ifdef MALLOC_STATS
+/* The largest free chunk, to tell how fragmented the heap is */
+static INTERNAL_SIZE_T max_free_chunk;
+
 static void malloc_update_mallinfo()
 {
   int i;
@@ -2314,6 +2394,10 @@ static void malloc_update_mallinfo()
 
   INTERNAL_SIZE_T avail = chunksize(top);
   int   navail = ((long)(avail) >= (long)MINSIZE)? 1 : 0;
+  INTERNAL_SIZE_T cached = 0;
+  int   ncached = 0;
+
+  max_free_chunk = avail;
 
   for (i = 1; i < NAV; ++i)
   {
@@ -2329,18 +2413,33 @@ static void malloc_update_mallinfo()
 #endif
       avail += chunksize(p);
       navail++;
+      if (chunksize(p) > max_free_chunk)
+	max_free_chunk = chunksize(p);
     }
   }
 
+#if CONFIG_IS_ENABLED(SYS_MALLOC_TCACHE)
+  /* Cached chunks are free as far as the caller is concerned */
+  for (i = 0; i < TCACHE_BINS; i++)
+  {
+    cached += (INTERNAL_SIZE_T)tcache_count[i] * i * MALLOC_ALIGNMENT;
+    ncached += tcache_count[i];
+  }
+#endif
+
   current_mallinfo.ordblks = navail;
-  current_mallinfo.uordblks = sbrked_mem - avail;
-  current_mallinfo.fordblks = avail;
+  current_mallinfo.smblks = ncached;
+  current_mallinfo.uordblks = sbrked_mem - avail - cached;
+  current_mallinfo.fsmblks = cached;
+  current_mallinfo.fordblks = avail + cached;
+#ifdef DEBUG
   current_mallinfo.hblks = n_mmaps;
+#endif
   current_mallinfo.hblkhd = mmapped_mem;
   current_mallinfo.keepcost = chunksize(top);
 
 }
-#endif	/* DEBUG */
+#endif	/* MALLOC_STATS */
 
 
 
@@ -2359,34 +2458,46 @@ static void malloc_update_mallinfo()
 
 */
 
-#ifdef DEBUG
+#ifdef MALLOC_STATS
 void malloc_stats()
 {
   malloc_update_mallinfo();
+  printf("heap size        = %10u\n",
+	  (unsigned int)(mem_malloc_end - mem_malloc_start));
   printf("max system bytes = %10u\n",
 	  (unsigned int)(max_total_mem));
   printf("system bytes     = %10u\n",
 	  (unsigned int)(sbrked_mem + mmapped_mem));
   printf("in use bytes     = %10u\n",
 	  (unsigned int)(current_mallinfo.uordblks + mmapped_mem));
+  printf("free bytes       = %10u in %u chunks\n",
+	  (unsigned int)current_mallinfo.fordblks,
+	  (unsigned int)(current_mallinfo.ordblks + current_mallinfo.smblks));
+  printf("largest free     = %10u\n",
+	  (unsigned int)max_free_chunk);
+#if CONFIG_IS_ENABLED(SYS_MALLOC_TCACHE)
+  printf("cached bytes     = %10u in %u chunks\n",
+	  (unsigned int)current_mallinfo.fsmblks,
+	  (unsigned int)current_mallinfo.smblks);
+#endif
 #if HAVE_MMAP
   printf("max mmap regions = %10u\n",
 	  (unsigned int)max_n_mmaps);
 #endif
 }
-#endif	/* DEBUG */
+#endif	/* MALLOC_STATS */
 
 /*
   mallinfo returns a copy of updated current mallinfo.
 */
 
-#ifdef DEBUG
+#ifdef MALLOC_STATS
 struct mallinfo mALLINFo()
 {
   malloc_update_mallinfo();
   return current_mallinfo;
 }
-#endif	/* DEBUG */
+#endif	/* MALLOC_STATS */
 
 
 
@@ -542,23 +542,16 @@ void fdt_fixup_ethernet(void *fdt)
 	const struct fdt_property *fdt_prop;
 #endif
 
-	if (fdt_path_offset(fdt, "/aliases") < 0)
+	offset = fdt_path_offset(fdt, "/aliases");
+	if (offset < 0)
 		return;
 
 	/* Cycle through all aliases */
-	for (prop = 0; ; prop++) {
+	for (prop = 0, offset = fdt_first_property_offset(fdt, offset);
+	     offset >= 0;
+	     prop++, offset = fdt_next_property_offset(fdt, offset)) {
 		const char *name;
 
-		/* FDT might have been edited, recompute the offset */
-		offset = fdt_first_property_offset(fdt,
-			fdt_path_offset(fdt, "/aliases"));
-		/* Select property number 'prop' */
-		for (j = 0; j < prop; j++)
-			offset = fdt_next_property_offset(fdt, offset);
-
-		if (offset < 0)
-			break;
-
 		path = fdt_getprop_by_offset(fdt, offset, &name, NULL);
 		if (!strncmp(name, "ethernet", 8)) {
 			/* Treat plain "ethernet" same as "ethernet0". */
@@ -603,6 +596,15 @@ void fdt_fixup_ethernet(void *fdt)
 					 &mac_addr, 6, 0);
 			do_fixup_by_path(fdt, path, "local-mac-address",
 					 &mac_addr, 6, 1);
+
+			/*
+			 * The FDT has been edited, recompute the offset of
+			 * property number 'prop'
+			 */
+			offset = fdt_first_property_offset(fdt,
+				fdt_path_offset(fdt, "/aliases"));
+			for (j = 0; j < prop; j++)
+				offset = fdt_next_property_offset(fdt, offset);
 		}
 	}
 }
@@ -366,8 +366,13 @@ static int spl_load_fit_image(struct spl_load_info *info, ulong sector,
 			return -EIO;
 		}
 		length = size;
-	} else {
-		memcpy(load_ptr, src, length);
+	} else if (load_ptr != src) {
+		/*
+		 * External data is read to an aligned address right at
+		 * load_addr, so it is either in place already (nothing to
+		 * copy) or shifted by less than a block and overlapping.
+		 */
+		memmove(load_ptr, src, length);
 	}
 
 	if (image_info) {
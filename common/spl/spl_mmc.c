@@ -393,6 +393,22 @@ int __weak spl_mmc_emmc_boot_partition(struct mmc *mmc)
 	return default_spl_mmc_emmc_boot_partition(mmc);
 }
 
+static int spl_mmc_select_hwpart(struct mmc *mmc, int part)
+{
+	int err;
+
+	if (CONFIG_IS_ENABLED(MMC_TINY))
+		err = mmc_switch_part(mmc, part);
+	else
+		err = blk_dselect_hwpart(mmc_get_blk_desc(mmc), part);
+
+#ifdef CONFIG_SPL_LIBCOMMON_SUPPORT
+	if (err)
+		puts("spl: mmc partition switch failed\n");
+#endif
+	return err;
+}
+
 int spl_mmc_load(struct spl_image_info *spl_image,
 		 struct spl_boot_device *bootdev,
 		 const char *filename,
@@ -426,25 +442,29 @@ int spl_mmc_load(struct spl_image_info *spl_image,
 	case MMCSD_MODE_EMMCBOOT:
 		part = spl_mmc_emmc_boot_partition(mmc);
 
-		if (CONFIG_IS_ENABLED(MMC_TINY))
-			err = mmc_switch_part(mmc, part);
-		else
-			err = blk_dselect_hwpart(mmc_get_blk_desc(mmc), part);
-
-		if (err) {
-#ifdef CONFIG_SPL_LIBCOMMON_SUPPORT
-			puts("spl: mmc partition switch failed\n");
-#endif
+		err = spl_mmc_select_hwpart(mmc, part);
+		if (err)
 			return err;
-		}
 		/* Fall through */
 	case MMCSD_MODE_RAW:
 		debug("spl: mmc boot mode: raw\n");
 
 		if (!spl_start_uboot()) {
-			err = mmc_load_image_raw_os(spl_image, bootdev, mmc);
+			bool user_area = boot_mode == MMCSD_MODE_EMMCBOOT &&
+				IS_ENABLED(CONFIG_SYS_MMCSD_RAW_MODE_KERNEL_USER_AREA);
+
+			if (!user_area || !spl_mmc_select_hwpart(mmc, 0))
+				err = mmc_load_image_raw_os(spl_image, bootdev,
+							    mmc);
 			if (!err)
 				return err;
+
+			/* U-Boot is in the boot partition */
+			if (user_area) {
+				err = spl_mmc_select_hwpart(mmc, part);
+				if (err)
+					return err;
+			}
 		}
 
 #ifndef CONFIG_DUAL_BOOTLOADER
@@ -23,6 +23,7 @@
 #include <i2c.h>
 #include <asm/global_data.h>
 #include <dm/device-internal.h>
+#include <dm/uclass-internal.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -305,9 +306,26 @@ int stdio_init_tables(void)
 	return 0;
 }
 
-int stdio_add_devices(void)
+#ifdef CONFIG_DM
+void stdio_probe_uclass(enum uclass_id id)
 {
 	struct udevice *dev;
+	int ret;
+
+	for (uclass_find_first_device(id, &dev); dev;
+	     uclass_find_next_device(&dev)) {
+		if (device_probe_on_demand(dev))
+			continue;
+		ret = device_probe(dev);
+		if (ret)
+			printf("Failed to probe %s '%s' (ret=%d)\n",
+			       dev->uclass->uc_drv->name, dev->name, ret);
+	}
+}
+#endif
+
+int stdio_add_devices(void)
+{
 	struct uclass *uc;
 	int ret;
 
@@ -331,12 +349,7 @@ int stdio_add_devices(void)
 		 * Don't report errors to the caller - assume that they are
 		 * non-fatal
 		 */
-		uclass_foreach_dev(dev, uc) {
-			ret = device_probe(dev);
-			if (ret)
-				printf("Failed to probe keyboard '%s'\n",
-				       dev->name);
-		}
+		stdio_probe_uclass(UCLASS_KEYBOARD);
 	}
 #if CONFIG_IS_ENABLED(SYS_I2C_LEGACY)
 	i2c_init_all();
@@ -354,18 +367,8 @@ int stdio_add_devices(void)
 		 * So just probe all video devices now so that whichever one is
 		 * required will be available.
 		 */
-		struct udevice *vdev;
-		int ret;
-
-		if (!IS_ENABLED(CONFIG_SYS_CONSOLE_IS_IN_ENV)) {
-			for (ret = uclass_first_device(UCLASS_VIDEO, &vdev);
-			     vdev;
-			     ret = uclass_next_device(&vdev))
-				;
-			if (ret)
-				printf("%s: Video device failed (ret=%d)\n",
-				       __func__, ret);
-		}
+		if (!IS_ENABLED(CONFIG_SYS_CONSOLE_IS_IN_ENV))
+			stdio_probe_uclass(UCLASS_VIDEO);
 		if (IS_ENABLED(CONFIG_SPLASH_SCREEN) &&
 		    IS_ENABLED(CONFIG_CMD_BMP))
 			splash_display();
@@ -115,6 +115,20 @@ int usb_stor_get_info(struct usb_device *dev, struct us_data *us,
 		      struct blk_desc *dev_desc);
 int usb_storage_probe(struct usb_device *dev, unsigned int ifnum,
 		      struct us_data *ss);
+/*
+ * max_xfer_blk is counted in 512 byte sectors, scale it so that devices with
+ * larger sectors stay within the byte limit of the host controller.
+ */
+static unsigned short usb_stor_max_blks(struct us_data *ss,
+					struct blk_desc *block_dev)
+{
+	if (block_dev->blksz <= 512)
+		return ss->max_xfer_blk;
+
+	return max_t(unsigned long, ss->max_xfer_blk * 512 / block_dev->blksz,
+		     1);
+}
+
 #if CONFIG_IS_ENABLED(BLK)
 static unsigned long usb_stor_read(struct udevice *dev, lbaint_t blknr,
 				   lbaint_t blkcnt, void *buffer);
@@ -958,9 +972,16 @@ static void usb_stor_set_max_xfer_blk(struct usb_device *udev,
 	 * Windows 7 limiting transfers to 128 sectors for both USB2 and USB3
 	 * and Apple Mac OS X 10.11 limiting transfers to 256 sectors for USB2
 	 * and 2048 for USB3 devices.
+	 *
+	 * Like Linux, allow 2048 sectors for SuperSpeed devices. Each transfer
+	 * is a full CBW/data/CSW round trip, so the larger size is what gets
+	 * USB3 sticks anywhere near the link rate.
 	 */
 	unsigned short blk = 240;
 
+	if (udev->speed >= USB_SPEED_SUPER)
+		blk = 2048;
+
 #if CONFIG_IS_ENABLED(DM_USB)
 	size_t size;
 	int ret;
@@ -1134,7 +1155,7 @@ static unsigned long usb_stor_read(struct blk_desc *block_dev, lbaint_t blknr,
 {
 	lbaint_t start, blks;
 	uintptr_t buf_addr;
-	unsigned short smallblks;
+	unsigned short smallblks, max_blks;
 	struct usb_device *udev;
 	struct us_data *ss;
 	int retry;
@@ -1159,6 +1180,7 @@ static unsigned long usb_stor_read(struct blk_desc *block_dev, lbaint_t blknr,
 	}
 #endif
 	ss = (struct us_data *)udev->privptr;
+	max_blks = usb_stor_max_blks(ss, block_dev);
 
 	usb_disable_asynch(1); /* asynch transfer not allowed */
 	usb_lock_async(udev, 1);
@@ -1174,12 +1196,12 @@ static unsigned long usb_stor_read(struct blk_desc *block_dev, lbaint_t blknr,
 		/* XXX need some comment here */
 		retry = 2;
 		srb->pdata = (unsigned char *)buf_addr;
-		if (blks > ss->max_xfer_blk)
-			smallblks = ss->max_xfer_blk;
+		if (blks > max_blks)
+			smallblks = max_blks;
 		else
 			smallblks = (unsigned short) blks;
 retry_it:
-		if (smallblks == ss->max_xfer_blk)
+		if (smallblks == max_blks)
 			usb_show_progress();
 		srb->datalen = block_dev->blksz * smallblks;
 		srb->pdata = (unsigned char *)buf_addr;
@@ -1202,7 +1224,7 @@ retry_it:
 
 	usb_lock_async(udev, 0);
 	usb_disable_asynch(0); /* asynch transfer allowed */
-	if (blkcnt >= ss->max_xfer_blk)
+	if (blkcnt >= max_blks)
 		debug("\n");
 	return blkcnt;
 }
@@ -1217,7 +1239,7 @@ static unsigned long usb_stor_write(struct blk_desc *block_dev, lbaint_t blknr,
 {
 	lbaint_t start, blks;
 	uintptr_t buf_addr;
-	unsigned short smallblks;
+	unsigned short smallblks, max_blks;
 	struct usb_device *udev;
 	struct us_data *ss;
 	int retry;
@@ -1243,6 +1265,7 @@ static unsigned long usb_stor_write(struct blk_desc *block_dev, lbaint_t blknr,
 	}
 #endif
 	ss = (struct us_data *)udev->privptr;
+	max_blks = usb_stor_max_blks(ss, block_dev);
 
 	usb_disable_asynch(1); /* asynch transfer not allowed */
 	usb_lock_async(udev, 1);
@@ -1261,12 +1284,12 @@ static unsigned long usb_stor_write(struct blk_desc *block_dev, lbaint_t blknr,
 		 */
 		retry = 2;
 		srb->pdata = (unsigned char *)buf_addr;
-		if (blks > ss->max_xfer_blk)
-			smallblks = ss->max_xfer_blk;
+		if (blks > max_blks)
+			smallblks = max_blks;
 		else
 			smallblks = (unsigned short) blks;
 retry_it:
-		if (smallblks == ss->max_xfer_blk)
+		if (smallblks == max_blks)
 			usb_show_progress();
 		srb->datalen = block_dev->blksz * smallblks;
 		srb->pdata = (unsigned char *)buf_addr;
@@ -1289,7 +1312,7 @@ retry_it:
 
 	usb_lock_async(udev, 0);
 	usb_disable_asynch(0); /* asynch transfer allowed */
-	if (blkcnt >= ss->max_xfer_blk)
+	if (blkcnt >= max_blks)
 		debug("\n");
 	return blkcnt;
 
@@ -1348,6 +1371,13 @@ int usb_storage_probe(struct usb_device *dev, unsigned int ifnum,
 		ss->transport = usb_stor_BBB_transport;
 		ss->transport_reset = usb_stor_BBB_reset;
 		break;
+	case US_PR_UAS:
+		/*
+		 * UAS devices offer Bulk-Only Transport as alternate setting
+		 * 0, which is what we select below. This one has none.
+		 */
+		printf("USB Attached SCSI without Bulk-Only fallback not supported\n");
+		return 0;
 	default:
 		printf("USB Storage Transport unknown / not yet implemented\n");
 		return 0;
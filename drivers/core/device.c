@@ -9,6 +9,7 @@
  */
 
 #include <common.h>
+#include <bootstage.h>
 #include <cpu_func.h>
 #include <log.h>
 #include <asm/global_data.h>
@@ -485,6 +486,7 @@ static int device_get_dma_constraints(struct udevice *dev)
 int device_probe(struct udevice *dev)
 {
 	const struct driver *drv;
+	__maybe_unused uint32_t start_us = 0;
 	int ret;
 
 	if (!dev)
@@ -516,6 +518,9 @@ int device_probe(struct udevice *dev)
 			return 0;
 	}
 
+	if (CONFIG_IS_ENABLED(BOOTSTAGE_DM_PROBE))
+		start_us = timer_get_boot_us();
+
 	dev_or_flags(dev, DM_FLAG_ACTIVATED);
 
 	if (CONFIG_IS_ENABLED(POWER_DOMAIN) && dev->parent &&
@@ -597,6 +602,16 @@ int device_probe(struct udevice *dev)
 				  dev->name, ret, errno_str(ret));
 	}
 
+#if CONFIG_IS_ENABLED(BOOTSTAGE_DM_PROBE)
+	if ((uint32_t)timer_get_boot_us() - start_us >=
+	    CONFIG_BOOTSTAGE_DM_PROBE_MIN_US) {
+		char name[40];
+
+		snprintf(name, sizeof(name), "probe:%s", dev->name);
+		bootstage_add_accum(name, start_us);
+	}
+#endif
+
 	return 0;
 fail_uclass:
 	if (device_remove(dev, DM_REMOVE_NORMAL)) {
@@ -1108,6 +1123,27 @@ void dev_set_uclass_plat(struct udevice *dev, void *uclass_plat)
 	dev->uclass_plat_ = uclass_plat;
 }
 
+#if CONFIG_IS_ENABLED(DM_PROBE_ON_DEMAND)
+bool device_probe_on_demand(const struct udevice *dev)
+{
+	const char *list = CONFIG_DM_PROBE_ON_DEMAND_UCLASSES;
+	const char *name = dev->uclass->uc_drv->name;
+	int len = strlen(name);
+	const char *p;
+
+	if (dev_read_bool(dev, "u-boot,probe-on-demand"))
+		return true;
+
+	for (p = strstr(list, name); p; p = strstr(p + len, name)) {
+		if ((p == list || p[-1] == ' ') &&
+		    (p[len] == '\0' || p[len] == ' '))
+			return true;
+	}
+
+	return false;
+}
+#endif
+
 #if CONFIG_IS_ENABLED(OF_REAL)
 bool device_is_compatible(const struct udevice *dev, const char *compat)
 {
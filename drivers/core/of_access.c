@@ -29,6 +29,7 @@
 #include <linux/ctype.h>
 #include <linux/err.h>
 #include <linux/ioport.h>
+#include <linux/log2.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -47,6 +48,11 @@ static struct device_node *of_stdout;
 /* pointer to options given after the alias (separated by :) or NULL if none */
 static const char *of_stdout_options;
 
+/* nodes by phandle, indexed by phandle & of_phandle_mask, for of_phandle_root */
+static struct device_node **of_phandle_cache;
+static struct device_node *of_phandle_root;
+static u32 of_phandle_mask;
+
 /**
  * struct alias_prop - Alias property in 'aliases' node
  *
@@ -446,6 +452,14 @@ struct device_node *of_find_node_by_phandle(phandle handle)
 	if (!handle)
 		return NULL;
 
+	if (of_phandle_cache && of_phandle_root == gd->of_root) {
+		np = of_phandle_cache[handle & of_phandle_mask];
+		if (np && np->phandle == handle) {
+			(void)of_node_get(np);
+			return np;
+		}
+	}
+
 	for_each_of_allnodes(np)
 		if (np->phandle == handle)
 			break;
@@ -777,6 +791,37 @@ static void of_alias_add(struct alias_prop *ap, struct device_node *np,
 	      ap->alias, ap->stem, ap->id, of_node_full_name(np));
 }
 
+int of_phandle_cache_init(void)
+{
+	struct device_node *np;
+	u32 count = 0;
+
+	for_each_of_allnodes(np) {
+		if (np->phandle)
+			count++;
+	}
+	if (!count)
+		return 0;
+
+	/* dtc numbers phandles from 1, so this rarely has collisions */
+	free(of_phandle_cache);
+	of_phandle_mask = roundup_pow_of_two(count + 1) - 1;
+	of_phandle_cache = calloc(of_phandle_mask + 1, sizeof(np));
+	if (!of_phandle_cache)
+		return -ENOMEM;
+	of_phandle_root = gd->of_root;
+
+	for_each_of_allnodes(np) {
+		struct device_node **slot;
+
+		slot = &of_phandle_cache[np->phandle & of_phandle_mask];
+		if (np->phandle && !*slot)
+			*slot = np;
+	}
+
+	return 0;
+}
+
 int of_alias_scan(void)
 {
 	struct property *pp;
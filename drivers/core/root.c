@@ -194,6 +194,9 @@ int dm_init(bool of_live)
 			return ret;
 		if (CONFIG_IS_ENABLED(OF_CONTROL))
 			dev_set_ofnode(DM_ROOT_NON_CONST, ofnode_root());
+		ret = uclass_index_init();
+		if (ret)
+			return ret;
 		ret = device_probe(DM_ROOT_NON_CONST);
 		if (ret)
 			return ret;
@@ -209,6 +212,7 @@ int dm_uninit(void)
 	device_remove(dm_root(), DM_REMOVE_NORMAL);
 	device_unbind(dm_root());
 	gd->dm_root = NULL;
+	uclass_index_uninit();
 
 	return 0;
 }
@@ -371,6 +371,102 @@ int uclass_find_device_by_of_offset(enum uclass_id id, int node,
 	return -ENODEV;
 }
 
+#if CONFIG_IS_ENABLED(DM_OFNODE_INDEX)
+#define UCLASS_INDEX_BITS	7
+#define UCLASS_INDEX_SIZE	(1 << UCLASS_INDEX_BITS)
+
+static struct hlist_head *uclass_index_head(ofnode node)
+{
+	/* Both node offsets and node pointers are at least 4-byte aligned */
+	u32 key = (ulong)node.of_offset >> 2;
+
+	return &gd->dm_ofnode_index[(key * 0x9e3779b1) >>
+				    (32 - UCLASS_INDEX_BITS)];
+}
+
+static void uclass_index_add(struct udevice *dev)
+{
+	if (gd->dm_ofnode_index && ofnode_valid(dev_ofnode(dev)))
+		hlist_add_head(&dev->index_node,
+			       uclass_index_head(dev_ofnode(dev)));
+}
+
+static void uclass_index_del(struct udevice *dev)
+{
+	hlist_del_init(&dev->index_node);
+}
+
+/**
+ * uclass_index_find() - Look up a device by node in the index
+ *
+ * @uc: uclass to search
+ * @node: device tree node to look for
+ * @devp: Returns the device found, or NULL if none
+ * Return: 0 if found, -ENODEV if not, -ENOSYS if there is no index, in which
+ *	case the caller must search the uclass
+ */
+static int uclass_index_find(struct uclass *uc, ofnode node,
+			     struct udevice **devp)
+{
+	struct hlist_node *pos;
+	struct udevice *dev;
+
+	*devp = NULL;
+	if (!gd->dm_ofnode_index)
+		return -ENOSYS;
+	if (!ofnode_valid(node))
+		return -ENODEV;
+
+	/*
+	 * Devices are added at the head, so keep the last match to return the
+	 * first device bound, as a search of the uclass would
+	 */
+	hlist_for_each_entry(dev, pos, uclass_index_head(node), index_node) {
+		if (dev->uclass == uc && ofnode_equal(dev_ofnode(dev), node))
+			*devp = dev;
+	}
+
+	return *devp ? 0 : -ENODEV;
+}
+
+int uclass_index_init(void)
+{
+	struct udevice *dev;
+	struct uclass *uc;
+
+	/* Keep the pre-relocation malloc() area for the devices themselves */
+	if (!(gd->flags & GD_FLG_RELOC))
+		return 0;
+
+	gd->dm_ofnode_index = calloc(UCLASS_INDEX_SIZE,
+				     sizeof(struct hlist_head));
+	if (!gd->dm_ofnode_index)
+		return -ENOMEM;
+
+	list_for_each_entry(uc, gd->uclass_root, sibling_node) {
+		uclass_foreach_dev(dev, uc)
+			uclass_index_add(dev);
+	}
+
+	return 0;
+}
+
+void uclass_index_uninit(void)
+{
+	free(gd->dm_ofnode_index);
+	gd->dm_ofnode_index = NULL;
+}
+#else
+static inline void uclass_index_add(struct udevice *dev) {}
+static inline void uclass_index_del(struct udevice *dev) {}
+
+static inline int uclass_index_find(struct uclass *uc, ofnode node,
+				    struct udevice **devp)
+{
+	return -ENOSYS;
+}
+#endif
+
 int uclass_find_device_by_ofnode(enum uclass_id id, ofnode node,
 				 struct udevice **devp)
 {
@@ -386,6 +482,10 @@ int uclass_find_device_by_ofnode(enum uclass_id id, ofnode node,
 	if (ret)
 		return ret;
 
+	ret = uclass_index_find(uc, node, devp);
+	if (ret != -ENOSYS)
+		goto done;
+
 	uclass_foreach_dev(dev, uc) {
 		log(LOGC_DM, LOGL_DEBUG_CONTENT, "      - checking %s\n",
 		    dev->name);
@@ -419,6 +519,14 @@ int uclass_find_device_by_phandle(enum uclass_id id, struct udevice *parent,
 	if (ret)
 		return ret;
 
+	/* A flat tree needs a full scan to find a phandle, so only use live */
+	if (of_live_active()) {
+		ret = uclass_index_find(uc, ofnode_get_by_phandle(find_phandle),
+					devp);
+		if (ret != -ENOSYS)
+			return ret;
+	}
+
 	uclass_foreach_dev(dev, uc) {
 		uint phandle;
 
@@ -540,6 +648,13 @@ int uclass_get_device_by_phandle_id(enum uclass_id id, uint phandle_id,
 	if (ret)
 		return ret;
 
+	if (of_live_active()) {
+		ret = uclass_index_find(uc, ofnode_get_by_phandle(phandle_id),
+					&dev);
+		if (ret != -ENOSYS)
+			return uclass_get_device_tail(dev, ret, devp);
+	}
+
 	uclass_foreach_dev(dev, uc) {
 		uint phandle;
 
@@ -680,6 +795,7 @@ int uclass_bind_device(struct udevice *dev)
 
 	uc = dev->uclass;
 	list_add_tail(&dev->uclass_node, &uc->dev_head);
+	uclass_index_add(dev);
 
 	if (dev->parent) {
 		struct uclass_driver *uc_drv = dev->parent->uclass->uc_drv;
@@ -695,6 +811,7 @@ int uclass_bind_device(struct udevice *dev)
 err:
 	/* There is no need to undo the parent's post_bind call */
 	list_del(&dev->uclass_node);
+	uclass_index_del(dev);
 
 	return ret;
 }
@@ -718,6 +835,7 @@ int uclass_pre_unbind_device(struct udevice *dev)
 int uclass_unbind_device(struct udevice *dev)
 {
 	list_del(&dev->uclass_node);
+	uclass_index_del(dev);
 
 	return 0;
 }
@@ -238,6 +238,16 @@ u32 fastboot_data_remaining(void)
 	return fastboot_bytes_expected - fastboot_bytes_received;
 }
 
+/**
+ * fastboot_data_buf() - return where the next received data belongs
+ *
+ * Return: Pointer into fastboot_buf_addr at the current download offset
+ */
+void *fastboot_data_buf(void)
+{
+	return fastboot_buf_addr + fastboot_bytes_received;
+}
+
 /**
  * fastboot_data_download() - Copy image data to fastboot_buf_addr.
  *
@@ -247,7 +257,8 @@ u32 fastboot_data_remaining(void)
  *
  * Copies image data from fastboot_data to fastboot_buf_addr. Writes to
  * response. fastboot_bytes_received is updated to indicate the number
- * of bytes that have been transferred.
+ * of bytes that have been transferred. Data that was received directly
+ * at fastboot_data_buf() is not copied.
  *
  * On completion sets image_size and ${filesize} to the total size of the
  * downloaded image.
@@ -266,9 +277,9 @@ void fastboot_data_download(const void *fastboot_data,
 			      response);
 		return;
 	}
-	/* Download data to fastboot_buf_addr */
-	memcpy(fastboot_buf_addr + fastboot_bytes_received,
-	       fastboot_data, fastboot_data_len);
+	/* Download data to fastboot_buf_addr, unless received in place */
+	if (fastboot_data != fastboot_data_buf())
+		memcpy(fastboot_data_buf(), fastboot_data, fastboot_data_len);
 
 	pre_dot_num = fastboot_bytes_received / BYTES_PER_DOT;
 	fastboot_bytes_received += fastboot_data_len;
@@ -76,10 +76,18 @@ static void mxs_nand_flush_cmd_buf(struct mxs_nand_info *info)
 
 	flush_dcache_range(addr, addr + MXS_NAND_COMMAND_BUFFER_SIZE);
 }
+
+static void mxs_nand_inval_page_buf(uint8_t *buf, uint32_t size)
+{
+	uintptr_t addr = (uintptr_t)buf;
+
+	invalidate_dcache_range(addr, addr + size);
+}
 #else
 static inline void mxs_nand_flush_data_buf(struct mxs_nand_info *info) {}
 static inline void mxs_nand_inval_data_buf(struct mxs_nand_info *info) {}
 static inline void mxs_nand_flush_cmd_buf(struct mxs_nand_info *info) {}
+static inline void mxs_nand_inval_page_buf(uint8_t *buf, uint32_t size) {}
 #endif
 
 static struct mxs_dma_desc *mxs_nand_get_dma_desc(struct mxs_nand_info *info)
@@ -668,6 +676,27 @@ static bool mxs_nand_erased_page(struct mtd_info *mtd, struct nand_chip *nand,
 	return true;
 }
 
+/*
+ * The BCH engine can write the page payload straight into the caller's
+ * buffer, saving a copy of each page, if that buffer is fit for DMA.
+ */
+static bool mxs_nand_can_dma_page(struct mtd_info *mtd,
+				  struct bch_geometry *geo, const uint8_t *buf)
+{
+	uintptr_t addr = (uintptr_t)buf;
+
+	if (!IS_ALIGNED(addr, MXS_DMA_ALIGNMENT) ||
+	    !IS_ALIGNED(mtd->writesize, MXS_DMA_ALIGNMENT))
+		return false;
+
+	/* The DMA descriptors only hold 32 bit addresses */
+	if (upper_32_bits((u64)addr + mtd->writesize - 1))
+		return false;
+
+	/* The block mark swapping must stay within the payload */
+	return geo->block_mark_byte_offset + 1 < mtd->writesize;
+}
+
 /*
  * Read a page from NAND.
  */
@@ -681,10 +710,13 @@ static int mxs_nand_ecc_read_page(struct mtd_info *mtd, struct nand_chip *nand,
 	struct mxs_dma_desc *d;
 	uint32_t channel = MXS_DMA_CHANNEL_AHB_APBH_GPMI0 + nand_info->cur_chip;
 	uint32_t corrected = 0, failed = 0;
-	uint8_t	*status;
+	uint8_t	*status, *payload = nand_info->data_buf;
 	int i, ret;
 	int flag = 0;
 
+	if (mxs_nand_can_dma_page(mtd, geo, buf))
+		payload = buf;
+
 	/* Compile the DMA descriptor - wait for ready. */
 	d = mxs_nand_get_dma_desc(nand_info);
 	d->cmd.data =
@@ -722,7 +754,7 @@ static int mxs_nand_ecc_read_page(struct mtd_info *mtd, struct nand_chip *nand,
 		GPMI_ECCCTRL_ECC_CMD_DECODE |
 		GPMI_ECCCTRL_BUFFER_MASK_BCH_PAGE;
 	d->cmd.pio_words[3] = mtd->writesize + mtd->oobsize;
-	d->cmd.pio_words[4] = (dma_addr_t)nand_info->data_buf;
+	d->cmd.pio_words[4] = (dma_addr_t)payload;
 	d->cmd.pio_words[5] = (dma_addr_t)nand_info->oob_buf;
 
 	if (nand_info->en_randomizer) {
@@ -765,6 +797,8 @@ static int mxs_nand_ecc_read_page(struct mtd_info *mtd, struct nand_chip *nand,
 
 	/* Invalidate caches */
 	mxs_nand_inval_data_buf(nand_info);
+	if (payload != nand_info->data_buf)
+		mxs_nand_inval_page_buf(payload, mtd->writesize);
 
 	/* Execute the DMA chain. */
 	ret = mxs_dma_go(channel);
@@ -783,9 +817,11 @@ static int mxs_nand_ecc_read_page(struct mtd_info *mtd, struct nand_chip *nand,
 
 	/* Invalidate caches */
 	mxs_nand_inval_data_buf(nand_info);
+	if (payload != nand_info->data_buf)
+		mxs_nand_inval_page_buf(payload, mtd->writesize);
 
 	/* Read DMA completed, now do the mark swapping. */
-	mxs_nand_swap_block_mark(geo, nand_info->data_buf, nand_info->oob_buf);
+	mxs_nand_swap_block_mark(geo, payload, nand_info->oob_buf);
 
 	/* Loop over status bytes, accumulating ECC status. */
 	status = nand_info->oob_buf + mxs_nand_aux_status_offset();
@@ -803,8 +839,7 @@ static int mxs_nand_ecc_read_page(struct mtd_info *mtd, struct nand_chip *nand,
 		}
 
 		if (status[i] == 0xfe) {
-			if (mxs_nand_erased_page(mtd, nand,
-						 nand_info->data_buf, i, page))
+			if (mxs_nand_erased_page(mtd, nand, payload, i, page))
 				break;
 			failed++;
 			continue;
@@ -830,7 +865,8 @@ static int mxs_nand_ecc_read_page(struct mtd_info *mtd, struct nand_chip *nand,
 
 	nand->oob_poi[0] = nand_info->oob_buf[0];
 
-	memcpy(buf, nand_info->data_buf, mtd->writesize);
+	if (payload != buf)
+		memcpy(buf, payload, mtd->writesize);
 
 	if (flag)
 		memset(buf, 0xff, mtd->writesize);
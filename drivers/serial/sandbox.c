@@ -20,6 +20,7 @@
 #include <linux/compiler.h>
 #include <asm/serial.h>
 #include <asm/state.h>
+#include <asm/test.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -67,11 +68,40 @@ static int sandbox_serial_remove(struct udevice *dev)
 	return 0;
 }
 
+void sandbox_serial_set_tx_full(struct udevice *dev, bool full)
+{
+	struct sandbox_serial_priv *priv = dev_get_priv(dev);
+
+	priv->tx_full = full;
+}
+
+void sandbox_serial_capture_tx(struct udevice *dev, char *buf, int size)
+{
+	struct sandbox_serial_priv *priv = dev_get_priv(dev);
+
+	priv->tx_buf = buf;
+	priv->tx_size = size;
+	priv->tx_len = 0;
+	if (buf)
+		*buf = '\0';
+}
+
 static int sandbox_serial_putc(struct udevice *dev, const char ch)
 {
 	struct sandbox_serial_priv *priv = dev_get_priv(dev);
 	struct sandbox_serial_plat *plat = dev_get_plat(dev);
 
+	if (priv->tx_full)
+		return -EAGAIN;
+
+	if (priv->tx_buf) {
+		if (priv->tx_len < priv->tx_size - 1) {
+			priv->tx_buf[priv->tx_len++] = ch;
+			priv->tx_buf[priv->tx_len] = '\0';
+		}
+		return 0;
+	}
+
 	/* With of-platdata we don't real the colour correctly, so disable it */
 	if (!CONFIG_IS_ENABLED(OF_PLATDATA) && priv->start_of_line &&
 	    plat->colour != -1) {
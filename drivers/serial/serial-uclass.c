@@ -185,6 +185,69 @@ int serial_initialize(void)
 	return serial_init();
 }
 
+#if CONFIG_IS_ENABLED(SERIAL_TX_BUFFER)
+/* Move as many chars from the TX buffer to the UART as it takes right now */
+static void serial_tx_drain(struct udevice *dev)
+{
+	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
+	struct dm_serial_ops *ops = serial_get_ops(dev);
+
+	while (upriv->tx_rd_ptr != upriv->tx_wr_ptr) {
+		if (ops->putc(dev, upriv->tx_buf[upriv->tx_rd_ptr]) == -EAGAIN)
+			break;
+		upriv->tx_rd_ptr++;
+		upriv->tx_rd_ptr %= CONFIG_SERIAL_TX_BUFFER_SIZE;
+	}
+}
+
+static void serial_tx_flush(struct udevice *dev)
+{
+	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
+
+	while (upriv->tx_rd_ptr != upriv->tx_wr_ptr)
+		serial_tx_drain(dev);
+}
+
+static bool serial_tx_put(struct udevice *dev, char ch)
+{
+	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
+	int next;
+
+	/* The buffer is only allocated after relocation */
+	if (!upriv->tx_buf)
+		return false;
+
+	next = (upriv->tx_wr_ptr + 1) % CONFIG_SERIAL_TX_BUFFER_SIZE;
+	while (next == upriv->tx_rd_ptr)
+		serial_tx_drain(dev);
+	upriv->tx_buf[upriv->tx_wr_ptr] = ch;
+	upriv->tx_wr_ptr = next;
+	serial_tx_drain(dev);
+
+	return true;
+}
+
+void serial_flush(void)
+{
+	struct udevice *dev;
+	struct uclass *uc;
+
+	/* With CONSOLE_MUX the console may be on more than one device */
+	uclass_id_foreach_dev(UCLASS_SERIAL, dev, uc) {
+		if (device_active(dev))
+			serial_tx_flush(dev);
+	}
+}
+#else
+static inline void serial_tx_drain(struct udevice *dev) {}
+static inline void serial_tx_flush(struct udevice *dev) {}
+
+static inline bool serial_tx_put(struct udevice *dev, char ch)
+{
+	return false;
+}
+#endif
+
 static void _serial_putc(struct udevice *dev, char ch)
 {
 	struct dm_serial_ops *ops = serial_get_ops(dev);
@@ -193,6 +256,9 @@ static void _serial_putc(struct udevice *dev, char ch)
 	if (ch == '\n')
 		_serial_putc(dev, '\r');
 
+	if (serial_tx_put(dev, ch))
+		return;
+
 	do {
 		err = ops->putc(dev, ch);
 	} while (err == -EAGAIN);
@@ -203,7 +269,8 @@ static void _serial_puts(struct udevice *dev, const char *str)
 	struct dm_serial_ops *ops = serial_get_ops(dev);
 	int err;
 
-	if (ops->puts) {
+	/* Buffered output goes through putc() so that it keeps its order */
+	if (ops->puts && !CONFIG_IS_ENABLED(SERIAL_TX_BUFFER)) {
 		do {
 			err = ops->puts(dev, str);
 		} while (err == -EAGAIN);
@@ -220,8 +287,10 @@ static int __serial_getc(struct udevice *dev)
 
 	do {
 		err = ops->getc(dev);
-		if (err == -EAGAIN)
+		if (err == -EAGAIN) {
+			serial_tx_drain(dev);
 			WATCHDOG_RESET();
+		}
 	} while (err == -EAGAIN);
 
 	return err >= 0 ? err : 0;
@@ -231,6 +300,9 @@ static int __serial_tstc(struct udevice *dev)
 {
 	struct dm_serial_ops *ops = serial_get_ops(dev);
 
+	/* ctrlc() and the command line poll here, so send pending output */
+	serial_tx_drain(dev);
+
 	if (ops->pending)
 		return ops->pending(dev, true);
 
@@ -314,6 +386,7 @@ void serial_setbrg(void)
 		return;
 
 	ops = serial_get_ops(gd->cur_serial_dev);
+	serial_tx_flush(gd->cur_serial_dev);
 	if (ops->setbrg)
 		ops->setbrg(gd->cur_serial_dev, gd->baudrate);
 }
@@ -502,6 +575,10 @@ static int serial_post_probe(struct udevice *dev)
 	/* Allocate the RX buffer */
 	upriv->buf = malloc(CONFIG_SERIAL_RX_BUFFER_SIZE);
 #endif
+#if CONFIG_IS_ENABLED(SERIAL_TX_BUFFER)
+	/* Allocate the TX buffer, output is unbuffered if this fails */
+	upriv->tx_buf = malloc(CONFIG_SERIAL_TX_BUFFER_SIZE);
+#endif
 
 	stdio_register_dev(&sdev, &upriv->sdev);
 #endif
@@ -510,12 +587,17 @@ static int serial_post_probe(struct udevice *dev)
 
 static int serial_pre_remove(struct udevice *dev)
 {
-#if CONFIG_IS_ENABLED(SYS_STDIO_DEREGISTER)
-	struct serial_dev_priv *upriv = dev_get_uclass_priv(dev);
+	struct serial_dev_priv *upriv __maybe_unused = dev_get_uclass_priv(dev);
 
+	serial_tx_flush(dev);
+#if CONFIG_IS_ENABLED(SYS_STDIO_DEREGISTER)
 	if (stdio_deregister_dev(upriv->sdev, true))
 		return -EPERM;
 #endif
+#if CONFIG_IS_ENABLED(SERIAL_TX_BUFFER)
+	free(upriv->tx_buf);
+	upriv->tx_buf = NULL;
+#endif
 
 	return 0;
 }
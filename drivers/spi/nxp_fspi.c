@@ -38,6 +38,7 @@
 #include <dm.h>
 #include <dm/device_compat.h>
 #include <malloc.h>
+#include <nxp_fspi.h>
 #include <spi.h>
 #include <spi-mem.h>
 #include <asm/io.h>
@@ -377,6 +378,9 @@ struct nxp_fspi {
 	u32 memmap_phy;
 	u32 memmap_phy_size;
 	u32 dll_slvdly;
+	u32 ahb_lut[NXP_FSPI_LUT_SIZE];
+	u32 speed_hz;
+	bool dtr;
 	struct clk clk, clk_en;
 	struct nxp_fspi_devtype_data *devtype_data;
 #define FSPI_DTR_ODD_ADDR       (1 << 0)
@@ -424,6 +428,20 @@ static int nxp_fspi_check_buswidth(struct nxp_fspi *f, u8 width)
 	return -ENOTSUPP;
 }
 
+/*
+ * Reads with an address which are large enough are done through the AHB
+ * bus, so they are only limited by the size of the memory mapped window.
+ */
+static u32 nxp_fspi_max_read_size(struct nxp_fspi *f,
+				  const struct spi_mem_op *op)
+{
+	if (!needs_ip_only(f) && op->addr.nbytes &&
+	    op->addr.val < f->memmap_phy_size)
+		return f->memmap_phy_size - op->addr.val;
+
+	return f->devtype_data->ahb_buf_size;
+}
+
 static bool nxp_fspi_supports_op(struct spi_slave *slave,
 				 const struct spi_mem_op *op)
 {
@@ -469,7 +487,7 @@ static bool nxp_fspi_supports_op(struct spi_slave *slave,
 
 	/* Max data length, check controller limits and alignment */
 	if (op->data.dir == SPI_MEM_DATA_IN &&
-	    (op->data.nbytes > f->devtype_data->ahb_buf_size ||
+	    (op->data.nbytes > nxp_fspi_max_read_size(f, op) ||
 	     (op->data.nbytes > f->devtype_data->rxfifo - 4 &&
 	      !IS_ALIGNED(op->data.nbytes, 8))))
 		return false;
@@ -478,6 +496,13 @@ static bool nxp_fspi_supports_op(struct spi_slave *slave,
 	    op->data.nbytes > f->devtype_data->txfifo)
 		return false;
 
+	/*
+	 * The LUT can describe DTR phases, but only for whole operations, as
+	 * the read strobe is switched over for them (see nxp_fspi_exec_op()).
+	 */
+	if (op->cmd.dtr && op->addr.dtr && op->dummy.dtr && op->data.dtr)
+		return spi_mem_dtr_supports_op(slave, op);
+
 	return spi_mem_default_supports_op(slave, op);
 }
 
@@ -518,12 +543,11 @@ static inline void nxp_fspi_invalid(struct nxp_fspi *f)
 	WARN_ON(ret);
 }
 
-static void nxp_fspi_prepare_lut(struct nxp_fspi *f,
-				 const struct spi_mem_op *op)
+TEST_STATIC void nxp_fspi_lut_gen(const struct spi_mem_op *op, u32 *lutval)
 {
-	void __iomem *base = f->iobase;
-	u32 lutval[4] = {};
-	int lutidx = 1, i;
+	int lutidx = 1;
+
+	memset(lutval, 0, NXP_FSPI_LUT_SIZE * sizeof(u32));
 
 	/* cmd */
 	if (op->cmd.dtr) {
@@ -572,6 +596,17 @@ static void nxp_fspi_prepare_lut(struct nxp_fspi *f,
 
 	/* stop condition. */
 	lutval[lutidx / 2] |= LUT_DEF(lutidx, LUT_STOP, 0, 0);
+}
+
+static void nxp_fspi_prepare_lut(struct nxp_fspi *f,
+				 const struct spi_mem_op *op)
+{
+	void __iomem *base = f->iobase;
+	u32 lutval[NXP_FSPI_LUT_SIZE];
+	bool ahb_update;
+	int i;
+
+	nxp_fspi_lut_gen(op, lutval);
 
 	/* unlock LUT */
 	fspi_writel(f, FSPI_LUTKEY_VALUE, f->iobase + FSPI_LUTKEY);
@@ -581,10 +616,17 @@ static void nxp_fspi_prepare_lut(struct nxp_fspi *f,
 	for (i = 0; i < ARRAY_SIZE(lutval); i++)
 		fspi_writel(f, lutval[i], base + FSPI_LUT_REG(i));
 
-	if (op->data.nbytes && op->data.dir == SPI_MEM_DATA_IN &&
-		op->addr.nbytes) {
+	/*
+	 * The AHB sequence is only rewritten when it changes, so that the
+	 * data prefetched by one read can still be used by the next one.
+	 */
+	ahb_update = op->data.nbytes && op->data.dir == SPI_MEM_DATA_IN &&
+		     op->addr.nbytes &&
+		     memcmp(f->ahb_lut, lutval, sizeof(lutval));
+	if (ahb_update) {
 		for (i = 0; i < ARRAY_SIZE(lutval); i++)
 			fspi_writel(f, lutval[i], base + FSPI_AHB_LUT_REG(i));
+		memcpy(f->ahb_lut, lutval, sizeof(lutval));
 	}
 
 	dev_dbg(f->dev, "CMD[%x] lutval[0:%x \t 1:%x \t 2:%x \t 3:%x], size: 0x%08x\n",
@@ -593,6 +635,10 @@ static void nxp_fspi_prepare_lut(struct nxp_fspi *f,
 	/* lock LUT */
 	fspi_writel(f, FSPI_LUTKEY_VALUE, f->iobase + FSPI_LUTKEY);
 	fspi_writel(f, FSPI_LCKER_LOCK, f->iobase + FSPI_LCKCR);
+
+	/* Data prefetched with another sequence must not be used */
+	if (ahb_update)
+		nxp_fspi_invalid(f);
 }
 
 #if CONFIG_IS_ENABLED(CLK)
@@ -620,6 +666,33 @@ static void nxp_fspi_clk_disable_unprep(struct nxp_fspi *f)
 }
 #endif
 
+/*
+ * The serial clock is half the root clock in DTR mode, so the root clock
+ * runs at twice the bus speed for DTR operations.
+ */
+static int nxp_fspi_set_rate(struct nxp_fspi *f)
+{
+#if CONFIG_IS_ENABLED(CLK)
+	unsigned long rate = f->speed_hz;
+	int ret;
+
+	if (f->dtr)
+		rate *= 2;
+
+	/* disable and unprepare clock to avoid glitch pass to controller */
+	nxp_fspi_clk_disable_unprep(f);
+
+	ret = clk_set_rate(&f->clk, rate);
+	if (ret < 0)
+		return ret;
+
+	ret = nxp_fspi_clk_prep_enable(f);
+	if (ret)
+		return ret;
+#endif
+	return 0;
+}
+
 /*
  * In FlexSPI controller, flash access is based on value of FSPI_FLSHXXCR0
  * register and start base address of the slave device.
@@ -674,6 +747,13 @@ static void nxp_fspi_select_mem(struct nxp_fspi *f, int chip_select)
 	fspi_writel(f, size_kb, f->iobase + FSPI_FLSHA1CR0 +
 		    4 * chip_select);
 
+	/*
+	 * The AHB buffer may hold data prefetched from the previously
+	 * selected flash, and the AHB sequence was set up for that flash.
+	 */
+	memset(f->ahb_lut, 0, sizeof(f->ahb_lut));
+	nxp_fspi_invalid(f);
+
 	dev_dbg(f->dev, "Slave device [CS:%x] selected\n", chip_select);
 }
 
@@ -880,6 +960,13 @@ static int nxp_fspi_exec_op(struct spi_slave *slave,
 				   FSPI_STS0_ARB_IDLE, 1, POLL_TOUT, true);
 	WARN_ON(err);
 
+	if (op->cmd.dtr != f->dtr) {
+		f->dtr = op->cmd.dtr;
+		err = nxp_fspi_set_rate(f);
+		if (err)
+			return err;
+	}
+
 	if (op->cmd.dtr && op->addr.dtr && op->dummy.dtr && op->data.dtr) {
 		reg = fspi_readl(f, f->iobase + FSPI_MCR0);
 		reg |= FSPI_MCR0_RXCLKSRC(3);
@@ -896,6 +983,8 @@ static int nxp_fspi_exec_op(struct spi_slave *slave,
 	if (op->data.nbytes > (f->devtype_data->rxfifo - 4) &&
 	    op->data.dir == SPI_MEM_DATA_IN &&
 	    !needs_ip_only(f)) {
+		/* The odd address fixup is only done for IP reads */
+		f->flags &= ~FSPI_DTR_ODD_ADDR;
 		nxp_fspi_read_ahb(f, op);
 	} else {
 		if (op->data.nbytes && op->data.dir == SPI_MEM_DATA_OUT)
@@ -904,8 +993,13 @@ static int nxp_fspi_exec_op(struct spi_slave *slave,
 		err = nxp_fspi_do_op(f, op);
 	}
 
-	/* Invalidate the data in the AHB buffer. */
-	nxp_fspi_invalid(f);
+	/*
+	 * Invalidate the data in the AHB buffer if the flash content may have
+	 * changed. Reads leave it alone, so that sequential reads benefit from
+	 * the prefetching.
+	 */
+	if (op->data.dir != SPI_MEM_DATA_IN)
+		nxp_fspi_invalid(f);
 
 	return err;
 }
@@ -929,9 +1023,9 @@ static int nxp_fspi_adjust_op_size(struct spi_slave *slave,
 			f->flags |= FSPI_DTR_ODD_ADDR;
 		}
 
-		if (op->data.nbytes > f->devtype_data->ahb_buf_size)
-			op->data.nbytes = f->devtype_data->ahb_buf_size;
-		else if (op->data.nbytes > (f->devtype_data->rxfifo - 4))
+		if (op->data.nbytes > nxp_fspi_max_read_size(f, op))
+			op->data.nbytes = nxp_fspi_max_read_size(f, op);
+		if (op->data.nbytes > (f->devtype_data->rxfifo - 4))
 			op->data.nbytes = ALIGN_DOWN(op->data.nbytes, 8);
 	}
 
@@ -988,19 +1082,12 @@ static int nxp_fspi_default_setup(struct nxp_fspi *f)
 	int ret, i;
 	u32 reg;
 
-#if CONFIG_IS_ENABLED(CLK)
-	/* disable and unprepare clock to avoid glitch pass to controller */
-	nxp_fspi_clk_disable_unprep(f);
-
 	/* the default frequency, we will change it later if necessary. */
-	ret = clk_set_rate(&f->clk, 20000000);
-	if (ret < 0)
-		return ret;
-
-	ret = nxp_fspi_clk_prep_enable(f);
+	f->speed_hz = 20000000;
+	f->dtr = false;
+	ret = nxp_fspi_set_rate(f);
 	if (ret)
 		return ret;
-#endif
 
 #ifdef CONFIG_FSL_LAYERSCAPE
 	/*
@@ -1067,6 +1154,10 @@ static int nxp_fspi_default_setup(struct nxp_fspi *f)
 	fspi_writel(f, SEQID_AHB_LUT, base + FSPI_FLSHB1CR2);
 	fspi_writel(f, SEQID_AHB_LUT, base + FSPI_FLSHB2CR2);
 
+	/* Force the AHB sequence to be written by the first read */
+	memset(f->ahb_lut, 0, sizeof(f->ahb_lut));
+	nxp_fspi_invalid(f);
+
 	return 0;
 }
 
@@ -1097,21 +1188,11 @@ static int nxp_fspi_claim_bus(struct udevice *dev)
 
 static int nxp_fspi_set_speed(struct udevice *bus, uint speed)
 {
-#if CONFIG_IS_ENABLED(CLK)
 	struct nxp_fspi *f = dev_get_priv(bus);
-	int ret;
 
-	nxp_fspi_clk_disable_unprep(f);
+	f->speed_hz = speed;
 
-	ret = clk_set_rate(&f->clk, speed);
-	if (ret < 0)
-		return ret;
-
-	ret = nxp_fspi_clk_prep_enable(f);
-	if (ret)
-		return ret;
-#endif
-	return 0;
+	return nxp_fspi_set_rate(f);
 }
 
 static int nxp_fspi_set_mode(struct udevice *bus, uint mode)
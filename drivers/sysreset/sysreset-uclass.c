@@ -14,6 +14,7 @@
 #include <hang.h>
 #include <log.h>
 #include <regmap.h>
+#include <serial.h>
 #include <spl.h>
 #include <sysreset.h>
 #include <dm/device-internal.h>
@@ -58,6 +59,8 @@ int sysreset_walk(enum sysreset_t type)
 	struct udevice *dev;
 	int ret = -ENOSYS;
 
+	/* Don't lose buffered console output to the reset */
+	serial_flush();
 	while (ret != -EINPROGRESS && type < SYSRESET_COUNT) {
 		for (uclass_first_device(UCLASS_SYSRESET, &dev);
 		     dev;
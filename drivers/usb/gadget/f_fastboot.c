@@ -40,6 +40,12 @@
  * that expect bulk OUT requests to be divisible by maxpacket size.
  */
 
+/*
+ * Downloads are received straight into the fastboot buffer, in requests of
+ * up to RX_DL_REQ_SIZE bytes, to keep the UDC busy and avoid a copy.
+ */
+#define RX_DL_REQ_SIZE			(1024 * 1024)
+
 typedef struct usb_req usb_req;
 struct usb_req {
 	struct usb_request *in_req;
@@ -52,6 +58,8 @@ struct f_fastboot {
 	/* IN/OUT EP's and corresponding requests */
 	struct usb_ep *in_ep, *out_ep;
 	struct usb_request *in_req, *out_req;
+	/* command buffer of out_req, which points elsewhere during downloads */
+	void *out_buf;
 
 	usb_req *front, *rear;
 };
@@ -326,7 +334,7 @@ static void fastboot_disable(struct usb_function *f)
 	usb_ep_disable(f_fb->in_ep);
 
 	if (f_fb->out_req) {
-		free(f_fb->out_req->buf);
+		free(f_fb->out_buf);
 		usb_ep_free_request(f_fb->out_ep, f_fb->out_req);
 		f_fb->out_req = NULL;
 	}
@@ -382,6 +390,7 @@ static int fastboot_set_alt(struct usb_function *f,
 		goto err;
 	}
 	f_fb->out_req->complete = rx_handler_command;
+	f_fb->out_buf = f_fb->out_req->buf;
 
 	d = fb_ep_desc(gadget, &fs_ep_in, &hs_ep_in, &ss_ep_in);
 	ret = usb_ep_enable(f_fb->in_ep, d);
@@ -529,8 +538,8 @@ static unsigned int rx_bytes_expected(struct usb_ep *ep)
 
 	if (rx_remain <= 0)
 		return 0;
-	else if (rx_remain > EP_BUFFER_SIZE)
-		return EP_BUFFER_SIZE;
+	else if (rx_remain > RX_DL_REQ_SIZE)
+		return RX_DL_REQ_SIZE;
 
 	/*
 	 * Some controllers e.g. DWC3 don't like OUT transfers to be
@@ -545,6 +554,29 @@ static unsigned int rx_bytes_expected(struct usb_ep *ep)
 	return rx_remain;
 }
 
+/*
+ * Point req at the download buffer. A transfer rounded up to maxpacket would
+ * reach past the end of the download, so the tail goes through the command
+ * buffer instead.
+ */
+static void rx_dl_prepare(struct usb_ep *ep, struct usb_request *req)
+{
+	unsigned int rx_remain = fastboot_data_remaining();
+	unsigned int maxpacket = usb_endpoint_maxp(ep->desc);
+
+	req->buf = fastboot_data_buf();
+	req->length = rx_bytes_expected(ep);
+	if (req->length <= rx_remain)
+		return;
+
+	if (req->length > EP_BUFFER_SIZE) {
+		req->length = rounddown(rx_remain, maxpacket);
+		return;
+	}
+
+	req->buf = fastboot_func->out_buf;
+}
+
 static void rx_handler_dl_image(struct usb_ep *ep, struct usb_request *req)
 {
 	char response[FASTBOOT_RESPONSE_LEN] = {0};
@@ -570,11 +602,12 @@ static void rx_handler_dl_image(struct usb_ep *ep, struct usb_request *req)
 		 * Reset global transfer variable
 		 */
 		req->complete = rx_handler_command;
+		req->buf = fastboot_func->out_buf;
 		req->length = EP_BUFFER_SIZE;
 
 		fastboot_tx_write_str(response);
 	} else {
-		req->length = rx_bytes_expected(ep);
+		rx_dl_prepare(ep, req);
 	}
 
 	req->actual = 0;
@@ -627,7 +660,7 @@ static void rx_handler_command(struct usb_ep *ep, struct usb_request *req)
 
 	if (!strncmp("DATA", response, 4)) {
 		req->complete = rx_handler_dl_image;
-		req->length = rx_bytes_expected(ep);
+		rx_dl_prepare(ep, req);
 	}
 
 	if (!strncmp("OKAY", response, 4)) {
@@ -281,55 +281,32 @@ static int sqfs_join(char **strings, char *dest, int start, int end,
 }
 
 /*
- * Fills the given token list using its size (count) and a source string (str)
+ * Fills the given token list using its size (count) and a source string (str).
+ * The tokens point into a single copy of the string, which is returned and
+ * must be freed by the caller once the tokens are no longer used.
  */
-static int sqfs_tokenize(char **tokens, int count, const char *str)
+static char *sqfs_tokenize(char **tokens, int count, const char *str)
 {
-	int i, j, ret = 0;
-	char *aux, *strc;
+	char *strc;
+	int j;
 
 	strc = strdup(str);
 	if (!strc)
-		return -ENOMEM;
+		return NULL;
 
 	if (!strcmp(strc, "/")) {
-		tokens[0] = strdup(strc);
-		if (!tokens[0]) {
-			ret = -ENOMEM;
-			goto free_strc;
-		}
+		tokens[0] = strc;
 	} else {
 		for (j = 0; j < count; j++) {
-			aux = strtok(!j ? strc : NULL, "/");
-			tokens[j] = strdup(aux);
+			tokens[j] = strtok(!j ? strc : NULL, "/");
 			if (!tokens[j]) {
-				for (i = 0; i < j; i++)
-					free(tokens[i]);
-				ret = -ENOMEM;
-				goto free_strc;
+				free(strc);
+				return NULL;
 			}
 		}
 	}
 
-free_strc:
-	free(strc);
-
-	return ret;
-}
-
-/*
- * Remove last 'updir + 1' tokens from the base path tokens list. This leaves us
- * with a token list containing only the tokens needed to form the resolved
- * path, and returns the decremented size of the token list.
- */
-static int sqfs_clean_base_path(char **base, int count, int updir)
-{
-	int i;
-
-	for (i = count - updir - 1; i < count; i++)
-		free(base[i]);
-
-	return count - updir - 1;
+	return strc;
 }
 
 /*
@@ -339,7 +316,8 @@ static int sqfs_clean_base_path(char **base, int count, int updir)
 static char *sqfs_get_abs_path(const char *base, const char *rel)
 {
 	char **base_tokens, **rel_tokens, *resolved = NULL;
-	int ret, bc, rc, i, updir = 0, resolved_size = 0, offset = 0;
+	char *base_buf = NULL, *rel_buf = NULL;
+	int bc, rc, i, updir = 0, resolved_size = 0, offset = 0;
 
 	base_tokens = NULL;
 	rel_tokens = NULL;
@@ -359,12 +337,12 @@ static char *sqfs_get_abs_path(const char *base, const char *rel)
 		goto out;
 
 	/* Fill token lists */
-	ret = sqfs_tokenize(base_tokens, bc, base);
-	if (ret)
+	base_buf = sqfs_tokenize(base_tokens, bc, base);
+	if (!base_buf)
 		goto out;
 
-	ret = sqfs_tokenize(rel_tokens, rc, rel);
-	if (ret)
+	rel_buf = sqfs_tokenize(rel_tokens, rc, rel);
+	if (!rel_buf)
 		goto out;
 
 	/* count '..' occurrences in target path */
@@ -373,8 +351,11 @@ static char *sqfs_get_abs_path(const char *base, const char *rel)
 			updir++;
 	}
 
-	/* Remove the last token and the '..' occurrences */
-	bc = sqfs_clean_base_path(base_tokens, bc, updir);
+	/*
+	 * Remove the last token and the '..' occurrences. This leaves only the
+	 * base tokens needed to form the resolved path.
+	 */
+	bc -= updir + 1;
 	if (bc < 0)
 		goto out;
 
@@ -396,13 +377,8 @@ static char *sqfs_get_abs_path(const char *base, const char *rel)
 	offset += sqfs_join(rel_tokens, resolved + offset, updir, rc, '/');
 
 out:
-	if (rel_tokens)
-		for (i = 0; i < rc; i++)
-			free(rel_tokens[i]);
-	if (base_tokens)
-		for (i = 0; i < bc; i++)
-			free(base_tokens[i]);
-
+	free(rel_buf);
+	free(base_buf);
 	free(rel_tokens);
 	free(base_tokens);
 
@@ -445,7 +421,7 @@ static int sqfs_search_dir(struct squashfs_dir_stream *dirs, char **token_list,
 			   int token_count, u32 *m_list, int m_count)
 {
 	struct squashfs_super_block *sblk = ctxt.sblk;
-	char *path, *target, **sym_tokens, *res, *rem;
+	char *path, *target, **sym_tokens, *sym_buf, *res, *rem;
 	int j, ret = 0, new_inode_number, offset;
 	struct squashfs_symlink_inode *sym;
 	struct squashfs_ldir_inode *ldir;
@@ -459,6 +435,7 @@ static int sqfs_search_dir(struct squashfs_dir_stream *dirs, char **token_list,
 	path = NULL;
 	target = NULL;
 	sym_tokens = NULL;
+	sym_buf = NULL;
 
 	dirsp = (struct fs_dir_stream *)dirs;
 
@@ -567,8 +544,8 @@ static int sqfs_search_dir(struct squashfs_dir_stream *dirs, char **token_list,
 			}
 
 			/* Fill tokens list */
-			ret = sqfs_tokenize(sym_tokens, token_count, res);
-			if (ret) {
+			sym_buf = sqfs_tokenize(sym_tokens, token_count, res);
+			if (!sym_buf) {
 				ret = -EINVAL;
 				goto out;
 			}
@@ -628,6 +605,7 @@ out:
 	free(rem);
 	free(path);
 	free(target);
+	free(sym_buf);
 	free(sym_tokens);
 	return ret;
 }
@@ -870,13 +848,57 @@ out:
 	return metablks_count;
 }
 
+static void sqfs_free_tables(void)
+{
+	free(ctxt.inode_table);
+	free(ctxt.dir_table);
+	free(ctxt.pos_list);
+	free(ctxt.frag_block);
+	ctxt.inode_table = NULL;
+	ctxt.dir_table = NULL;
+	ctxt.pos_list = NULL;
+	ctxt.frag_block = NULL;
+	ctxt.metablks_count = 0;
+	ctxt.cache_dev = NULL;
+}
+
+/*
+ * The inode and directory tables are only decompressed on first use; they
+ * are then kept in the context until a different filesystem is probed, so
+ * that loading several files from the same image does not decompress them
+ * again each time.
+ */
+static int sqfs_read_tables(void)
+{
+	int ret, metablks_count;
+
+	if (ctxt.inode_table)
+		return 0;
+
+	ret = sqfs_read_inode_table(&ctxt.inode_table);
+	if (ret)
+		return ret;
+
+	metablks_count = sqfs_read_directory_table(&ctxt.dir_table,
+						   &ctxt.pos_list);
+	if (metablks_count < 1) {
+		sqfs_free_tables();
+		return -EINVAL;
+	}
+
+	ctxt.metablks_count = metablks_count;
+	ctxt.cache_dev = ctxt.cur_dev;
+	ctxt.cache_start = ctxt.cur_part_info.start;
+	memcpy(&ctxt.cache_sblk, ctxt.sblk, sizeof(ctxt.cache_sblk));
+
+	return 0;
+}
+
 int sqfs_opendir(const char *filename, struct fs_dir_stream **dirsp)
 {
-	unsigned char *inode_table = NULL, *dir_table = NULL;
-	int j, token_count = 0, ret = 0, metablks_count;
+	int token_count = 0, ret = 0;
 	struct squashfs_dir_stream *dirs;
 	char **token_list = NULL, *path = NULL;
-	u32 *pos_list = NULL;
 
 	dirs = calloc(1, sizeof(*dirs));
 	if (!dirs)
@@ -889,18 +911,12 @@ int sqfs_opendir(const char *filename, struct fs_dir_stream **dirsp)
 	dirs->inode_table = NULL;
 	dirs->dir_table = NULL;
 
-	ret = sqfs_read_inode_table(&inode_table);
+	ret = sqfs_read_tables();
 	if (ret) {
 		ret = -EINVAL;
 		goto out;
 	}
 
-	metablks_count = sqfs_read_directory_table(&dir_table, &pos_list);
-	if (metablks_count < 1) {
-		ret = -EINVAL;
-		goto out;
-	}
-
 	/* Tokenize filename */
 	token_count = sqfs_count_tokens(filename);
 	if (token_count < 0) {
@@ -908,12 +924,6 @@ int sqfs_opendir(const char *filename, struct fs_dir_stream **dirsp)
 		goto out;
 	}
 
-	path = strdup(filename);
-	if (!path) {
-		ret = -EINVAL;
-		goto out;
-	}
-
 	token_list = malloc(token_count * sizeof(char *));
 	if (!token_list) {
 		ret = -EINVAL;
@@ -921,17 +931,19 @@ int sqfs_opendir(const char *filename, struct fs_dir_stream **dirsp)
 	}
 
 	/* Fill tokens list */
-	ret = sqfs_tokenize(token_list, token_count, path);
-	if (ret)
+	path = sqfs_tokenize(token_list, token_count, filename);
+	if (!path) {
+		ret = -ENOMEM;
 		goto out;
+	}
 	/*
 	 * ldir's (extended directory) size is greater than dir, so it works as
 	 * a general solution for the malloc size, since 'i' is a union.
 	 */
-	dirs->inode_table = inode_table;
-	dirs->dir_table = dir_table;
-	ret = sqfs_search_dir(dirs, token_list, token_count, pos_list,
-			      metablks_count);
+	dirs->inode_table = ctxt.inode_table;
+	dirs->dir_table = ctxt.dir_table;
+	ret = sqfs_search_dir(dirs, token_list, token_count, ctxt.pos_list,
+			      ctxt.metablks_count);
 	if (ret)
 		goto out;
 
@@ -952,15 +964,10 @@ int sqfs_opendir(const char *filename, struct fs_dir_stream **dirsp)
 	*dirsp = (struct fs_dir_stream *)dirs;
 
 out:
-	for (j = 0; j < token_count; j++)
-		free(token_list[j]);
 	free(token_list);
-	free(pos_list);
 	free(path);
-	if (ret) {
-		free(inode_table);
+	if (ret)
 		free(dirs);
-	}
 
 	return ret;
 }
@@ -1097,6 +1104,12 @@ int sqfs_probe(struct blk_desc *fs_dev_desc, struct disk_partition *fs_partition
 		goto error;
 	}
 
+	/* Only keep the cached metadata if this is the same filesystem */
+	if (ctxt.cache_dev != fs_dev_desc ||
+	    ctxt.cache_start != fs_partition->start ||
+	    memcmp(&ctxt.cache_sblk, sblk, sizeof(*sblk)))
+		sqfs_free_tables();
+
 	ctxt.sblk = sblk;
 
 	ret = sqfs_decompressor_init(&ctxt);
@@ -1106,6 +1119,7 @@ int sqfs_probe(struct blk_desc *fs_dev_desc, struct disk_partition *fs_partition
 
 	return 0;
 error:
+	sqfs_free_tables();
 	ctxt.cur_dev = NULL;
 	free(ctxt.sblk);
 	ctxt.sblk = NULL;
@@ -1307,13 +1321,81 @@ static int sqfs_get_lregfile_info(struct squashfs_lreg_inode *lreg,
 	return datablk_count;
 }
 
+/*
+ * Get the (decompressed) fragment block described by @frag_entry. Small files
+ * are packed together into fragment blocks, so the last one is kept in the
+ * context for the next file.
+ */
+static int sqfs_read_fragment(struct squashfs_fragment_block_entry *frag_entry,
+			      bool comp, char **fragment_block)
+{
+	u32 block_size = get_unaligned_le32(&ctxt.sblk->block_size);
+	u64 start, n_blks, table_size, table_offset;
+	unsigned long dest_len;
+	char *fragment;
+	int ret;
+
+	if (ctxt.frag_block && ctxt.frag_start == frag_entry->start) {
+		*fragment_block = ctxt.frag_block;
+		return 0;
+	}
+
+	start = frag_entry->start / ctxt.cur_dev->blksz;
+	table_size = SQFS_BLOCK_SIZE(frag_entry->size);
+	table_offset = frag_entry->start - (start * ctxt.cur_dev->blksz);
+	n_blks = DIV_ROUND_UP(table_size + table_offset, ctxt.cur_dev->blksz);
+
+	if (!comp && table_size > block_size)
+		return -EINVAL;
+
+	fragment = malloc_cache_aligned(n_blks * ctxt.cur_dev->blksz);
+	if (!fragment)
+		return -ENOMEM;
+
+	ret = sqfs_disk_read(start, n_blks, fragment);
+	if (ret < 0)
+		goto out;
+
+	if (!ctxt.frag_block) {
+		ctxt.frag_block = malloc(block_size);
+		if (!ctxt.frag_block) {
+			ret = -ENOMEM;
+			goto out;
+		}
+	}
+
+	if (comp) {
+		dest_len = block_size;
+		ret = sqfs_decompress(&ctxt, ctxt.frag_block, &dest_len,
+				      fragment + table_offset,
+				      frag_entry->size);
+		if (ret) {
+			free(ctxt.frag_block);
+			ctxt.frag_block = NULL;
+			goto out;
+		}
+	} else {
+		memcpy(ctxt.frag_block, fragment + table_offset, table_size);
+	}
+
+	ctxt.frag_start = frag_entry->start;
+	*fragment_block = ctxt.frag_block;
+	ret = 0;
+
+out:
+	free(fragment);
+
+	return ret;
+}
+
 int sqfs_read(const char *filename, void *buf, loff_t offset, loff_t len,
 	      loff_t *actread)
 {
 	char *dir = NULL, *fragment_block, *datablock = NULL, *data_buffer = NULL;
-	char *fragment = NULL, *file = NULL, *resolved, *data;
+	char *file = NULL, *resolved, *data;
 	u64 start, n_blks, table_size, data_offset, table_offset, sparse_size;
-	int ret, j, i_number, datablk_count = 0;
+	u64 batch_start = 0, batch_end = 0, batch_size, size;
+	int ret, j, k, i_number, datablk_count = 0;
 	struct squashfs_super_block *sblk = ctxt.sblk;
 	struct squashfs_fragment_block_entry frag_entry;
 	struct squashfs_file_info finfo = {0};
@@ -1440,21 +1522,28 @@ int sqfs_read(const char *filename, void *buf, loff_t offset, loff_t len,
 	}
 
 	for (j = 0; j < datablk_count; j++) {
-		start = data_offset / ctxt.cur_dev->blksz;
 		table_size = SQFS_BLOCK_SIZE(finfo.blk_sizes[j]);
-		table_offset = data_offset - (start * ctxt.cur_dev->blksz);
-		n_blks = DIV_ROUND_UP(table_size + table_offset,
-				      ctxt.cur_dev->blksz);
 
-		/* Don't load any data for sparse blocks */
-		if (finfo.blk_sizes[j] == 0) {
-			n_blks = 0;
-			table_offset = 0;
-			data_buffer = NULL;
-			data = NULL;
-		} else {
-			data_buffer = malloc_cache_aligned(n_blks * ctxt.cur_dev->blksz);
+		/*
+		 * Data blocks are stored back to back, so read as many of them
+		 * as fit in SQFS_READ_BATCH_SIZE with a single disk access.
+		 */
+		if (finfo.blk_sizes[j] && data_offset + table_size > batch_end) {
+			batch_size = table_size;
+			for (k = j + 1; k < datablk_count; k++) {
+				size = SQFS_BLOCK_SIZE(finfo.blk_sizes[k]);
+				if (batch_size + size > SQFS_READ_BATCH_SIZE)
+					break;
+				batch_size += size;
+			}
+
+			start = data_offset / ctxt.cur_dev->blksz;
+			table_offset = data_offset - (start * ctxt.cur_dev->blksz);
+			n_blks = DIV_ROUND_UP(batch_size + table_offset,
+					      ctxt.cur_dev->blksz);
 
+			free(data_buffer);
+			data_buffer = malloc_cache_aligned(n_blks * ctxt.cur_dev->blksz);
 			if (!data_buffer) {
 				ret = -ENOMEM;
 				goto out;
@@ -1471,7 +1560,8 @@ int sqfs_read(const char *filename, void *buf, loff_t offset, loff_t len,
 				goto out;
 			}
 
-			data = data_buffer + table_offset;
+			batch_start = start * ctxt.cur_dev->blksz;
+			batch_end = data_offset + batch_size;
 		}
 
 		/* Load the data */
@@ -1483,17 +1573,33 @@ int sqfs_read(const char *filename, void *buf, loff_t offset, loff_t len,
 			memset(buf + *actread, 0, sparse_size);
 			*actread += sparse_size;
 		} else if (SQFS_COMPRESSED_BLOCK(finfo.blk_sizes[j])) {
+			data = data_buffer + (data_offset - batch_start);
 			dest_len = get_unaligned_le32(&sblk->block_size);
-			ret = sqfs_decompress(&ctxt, datablock, &dest_len,
-					      data, table_size);
-			if (ret)
-				goto out;
 
-			if ((*actread + dest_len) > len)
-				dest_len = len - *actread;
-			memcpy(buf + *actread, datablock, dest_len);
+			/*
+			 * Full blocks are decompressed straight into the
+			 * destination, only the tail goes through 'datablock'.
+			 */
+			if (len - *actread >= dest_len) {
+				ret = sqfs_decompress(&ctxt, buf + *actread,
+						      &dest_len, data,
+						      table_size);
+				if (ret)
+					goto out;
+			} else {
+				ret = sqfs_decompress(&ctxt, datablock,
+						      &dest_len, data,
+						      table_size);
+				if (ret)
+					goto out;
+
+				if ((*actread + dest_len) > len)
+					dest_len = len - *actread;
+				memcpy(buf + *actread, datablock, dest_len);
+			}
 			*actread += dest_len;
 		} else {
+			data = data_buffer + (data_offset - batch_start);
 			if ((*actread + table_size) > len)
 				table_size = len - *actread;
 			memcpy(buf + *actread, data, table_size);
@@ -1501,9 +1607,6 @@ int sqfs_read(const char *filename, void *buf, loff_t offset, loff_t len,
 		}
 
 		data_offset += table_size;
-		if (data_buffer)
-			free(data_buffer);
-		data_buffer = NULL;
 		if (*actread >= len)
 			break;
 	}
@@ -1516,53 +1619,14 @@ int sqfs_read(const char *filename, void *buf, loff_t offset, loff_t len,
 		goto out;
 	}
 
-	start = frag_entry.start / ctxt.cur_dev->blksz;
-	table_size = SQFS_BLOCK_SIZE(frag_entry.size);
-	table_offset = frag_entry.start - (start * ctxt.cur_dev->blksz);
-	n_blks = DIV_ROUND_UP(table_size + table_offset, ctxt.cur_dev->blksz);
-
-	fragment = malloc_cache_aligned(n_blks * ctxt.cur_dev->blksz);
-
-	if (!fragment) {
-		ret = -ENOMEM;
-		goto out;
-	}
-
-	ret = sqfs_disk_read(start, n_blks, fragment);
-	if (ret < 0)
+	ret = sqfs_read_fragment(&frag_entry, finfo.comp, &fragment_block);
+	if (ret)
 		goto out;
 
-	/* File compressed and fragmented */
-	if (finfo.frag && finfo.comp) {
-		dest_len = get_unaligned_le32(&sblk->block_size);
-		fragment_block = malloc(dest_len);
-		if (!fragment_block) {
-			ret = -ENOMEM;
-			goto out;
-		}
-
-		ret = sqfs_decompress(&ctxt, fragment_block, &dest_len,
-				      (void *)fragment  + table_offset,
-				      frag_entry.size);
-		if (ret) {
-			free(fragment_block);
-			goto out;
-		}
-
-		memcpy(buf + *actread, &fragment_block[finfo.offset], finfo.size - *actread);
-		*actread = finfo.size;
-
-		free(fragment_block);
-
-	} else if (finfo.frag && !finfo.comp) {
-		fragment_block = (void *)fragment + table_offset;
-
-		memcpy(buf + *actread, &fragment_block[finfo.offset], finfo.size - *actread);
-		*actread = finfo.size;
-	}
+	memcpy(buf + *actread, &fragment_block[finfo.offset], finfo.size - *actread);
+	*actread = finfo.size;
 
 out:
-	free(fragment);
 	if (datablk_count) {
 		free(data_buffer);
 		free(datablock);
@@ -1718,8 +1782,6 @@ void sqfs_closedir(struct fs_dir_stream *dirs)
 		return;
 
 	sqfs_dirs = (struct squashfs_dir_stream *)dirs;
-	free(sqfs_dirs->inode_table);
-	free(sqfs_dirs->dir_table);
 	free(sqfs_dirs->dir_header);
 	free(sqfs_dirs);
 }
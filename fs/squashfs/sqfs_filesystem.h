@@ -29,6 +29,8 @@
 #define SQFS_EMPTY_FILE_SIZE 3
 #define SQFS_STOP_READDIR 1
 #define SQFS_EMPTY_DIR -1
+/* Upper limit for data blocks read from the disk at once */
+#define SQFS_READ_BATCH_SIZE (1024 * 1024)
 /*
  * A directory entry object has a fixed length of 8 bytes, corresponding to its
  * first four members, plus the size of the entry name, which is equal to
@@ -80,6 +82,20 @@ struct squashfs_ctxt {
 #if IS_ENABLED(CONFIG_ZSTD)
 	void *zstd_workspace;
 #endif
+	/*
+	 * Decompressed metadata, kept across operations for as long as the
+	 * same filesystem is probed again (see sqfs_probe()).
+	 */
+	struct squashfs_super_block cache_sblk;
+	struct blk_desc *cache_dev;
+	lbaint_t cache_start;
+	unsigned char *inode_table;
+	unsigned char *dir_table;
+	u32 *pos_list;
+	int metablks_count;
+	/* Last fragment block read, decompressed */
+	char *frag_block;
+	u64 frag_start;
 };
 
 struct squashfs_directory_index {
@@ -274,7 +290,7 @@ struct squashfs_dir_stream {
 	struct squashfs_ldir_inode i_ldir;
 	/*
 	 * References to the tables' beginnings. They are assigned in
-	 * sqfs_opendir() and freed in sqfs_closedir().
+	 * sqfs_opendir() and owned by the filesystem context.
 	 */
 	unsigned char *inode_table;
 	unsigned char *dir_table;
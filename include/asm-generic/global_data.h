@@ -225,6 +225,13 @@ struct global_data {
 	 */
 	void *dm_priv_base;
 # endif
+# if CONFIG_IS_ENABLED(DM_OFNODE_INDEX)
+	/**
+	 * @dm_ofnode_index: hash table of bound devices by device tree node,
+	 * or NULL if not set up yet
+	 */
+	struct hlist_head *dm_ofnode_index;
+# endif
 #endif
 #ifdef CONFIG_TIMER
 	/**
@@ -312,6 +312,19 @@ uint32_t bootstage_start(enum bootstage_id id, const char *name);
  */
 uint32_t bootstage_accum(enum bootstage_id id);
 
+/**
+ * Record the time spent in a named activity
+ *
+ * The time is added to the accumulator record of that name, which is
+ * allocated on first use, so it shows up in the 'Accumulated time' part of
+ * the report. The name is copied.
+ *
+ * @param name		Textual name to display in the report
+ * @param start_us	Start timestamp from timer_get_boot_us()
+ * Return: time spent in the activity
+ */
+uint32_t bootstage_add_accum(const char *name, uint32_t start_us);
+
 /* Print a report about boot time */
 void bootstage_report(void);
 
@@ -411,6 +424,12 @@ static inline uint32_t bootstage_accum(enum bootstage_id id)
 	return 0;
 }
 
+static inline uint32_t bootstage_add_accum(const char *name,
+					   uint32_t start_us)
+{
+	return 0;
+}
+
 static inline int bootstage_stash(void *base, int size)
 {
 	return 0;	/* Pretend to succeed */
@@ -154,6 +154,13 @@ BL31:           00960000..00980000
 #define CONFIG_SPL_FS_LOAD_PAYLOAD_NAME "u-boot"
 #endif
 
+#ifdef CONFIG_SPL_OS_BOOT
+/* DTB prepared with 'spl export fdt', in front of the falcon mode FIT image */
+#define CONFIG_SYS_SPL_ARGS_ADDR		CONFIG_FDTADDR
+#define CONFIG_SYS_MMCSD_RAW_MODE_ARGS_SECTOR	0x800	/* 1 MiB */
+#define CONFIG_SYS_MMCSD_RAW_MODE_ARGS_SECTORS	0x80	/* 64 KiB */
+#endif
+
 #endif /* CONFIG_SPL_BUILD */
 
 #define CONFIG_SYS_INIT_RAM_ADDR	CONFIG_SYS_SDRAM_BASE
@@ -158,6 +158,8 @@ enum {
  * (do not access outside driver model)
  * @node_: Reference to device tree node for this device (do not access outside
  *	driver model)
+ * @index_node: Used by uclass to index devices by device tree node (do not
+ *	access outside driver model)
  * @devres_head: List of memory allocations associated with this device.
  *		When CONFIG_DEVRES is enabled, devm_kmalloc() and friends will
  *		add to this list. Memory so-allocated will be freed
@@ -187,6 +189,9 @@ struct udevice {
 #if CONFIG_IS_ENABLED(OF_REAL)
 	ofnode node_;
 #endif
+#if CONFIG_IS_ENABLED(DM_OFNODE_INDEX)
+	struct hlist_node index_node;
+#endif
 #ifdef CONFIG_DEVRES
 	struct list_head devres_head;
 #endif
@@ -934,6 +939,25 @@ void device_set_name_alloced(struct udevice *dev);
  */
 bool device_is_compatible(const struct udevice *dev, const char *compat);
 
+/**
+ * device_probe_on_demand() - check if probing a device should be deferred
+ *
+ * Code which probes all devices of a uclass during start-up (e.g. to list
+ * them) should skip devices for which this returns true. They are probed
+ * when they are used.
+ *
+ * @dev:	Device to check
+ * Return: true if the device should only be probed on first use
+ */
+#if CONFIG_IS_ENABLED(DM_PROBE_ON_DEMAND)
+bool device_probe_on_demand(const struct udevice *dev);
+#else
+static inline bool device_probe_on_demand(const struct udevice *dev)
+{
+	return false;
+}
+#endif
+
 /**
  * of_machine_is_compatible() - check if the machine is compatible with
  *				the compat
@@ -473,6 +473,17 @@ int of_count_phandle_with_args(const struct device_node *np,
 			       const char *list_name, const char *cells_name,
 			       int cells_count);
 
+/**
+ * of_phandle_cache_init() - Set up the cache of nodes by phandle
+ *
+ * This makes of_find_node_by_phandle() take constant time for nodes in the
+ * live tree when it is built. Phandles which are missing from the cache are
+ * still found by searching the tree.
+ *
+ * Return: 0 if OK, -ENOMEM if not enough memory
+ */
+int of_phandle_cache_init(void);
+
 /**
  * of_alias_scan() - Scan all properties of the 'aliases' node
  *
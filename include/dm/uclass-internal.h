@@ -233,6 +233,27 @@ int uclass_find_device_by_ofnode(enum uclass_id id, ofnode node,
 int uclass_find_device_by_phandle(enum uclass_id id, struct udevice *parent,
 				  const char *name, struct udevice **devp);
 
+#if CONFIG_IS_ENABLED(DM_OFNODE_INDEX)
+/**
+ * uclass_index_init() - Set up the index of devices by device tree node
+ *
+ * This is used by uclass_find_device_by_ofnode() and the phandle lookups to
+ * avoid searching the whole uclass. Devices already bound are added to it.
+ * Before relocation there is no index and the uclass is searched instead.
+ *
+ * Return: 0 on success, -ENOMEM if out of memory
+ */
+int uclass_index_init(void);
+
+/**
+ * uclass_index_uninit() - Drop the index of devices by device tree node
+ */
+void uclass_index_uninit(void);
+#else
+static inline int uclass_index_init(void) { return 0; }
+static inline void uclass_index_uninit(void) {}
+#endif
+
 /**
  * uclass_bind_device() - Associate device with a uclass
  *
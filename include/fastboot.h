@@ -169,6 +169,16 @@ int fastboot_handle_command(char *cmd_string, char *response);
  */
 u32 fastboot_data_remaining(void);
 
+/**
+ * fastboot_data_buf() - return where the next received data belongs
+ *
+ * Transports may receive data directly into this buffer and pass it on to
+ * fastboot_data_download(), which then skips the copy.
+ *
+ * Return: Pointer into fastboot_buf_addr at the current download offset
+ */
+void *fastboot_data_buf(void);
+
 /**
  * fastboot_data_download() - Copy image data to fastboot_buf_addr.
  *
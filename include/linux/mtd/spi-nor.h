@@ -144,6 +144,13 @@
 #define SPINOR_REG_MT_CFR1V	0x01	/* For setting dummy cycles */
 #define SPINOR_MT_OCT_DTR	0xe7	/* Enable Octal DTR with DQS. */
 
+/* Used for Macronix octal flashes only. */
+#define SPINOR_OP_MXIC_WR_ANY_REG	0x72	/* Write configuration register 2 */
+#define SPINOR_REG_MXIC_CR2_MODE	0x00000000	/* For setting octal DTR mode */
+#define SPINOR_REG_MXIC_CR2_DC		0x00000300	/* For setting dummy cycles */
+#define SPINOR_REG_MXIC_OPI_DTR_EN	0x02	/* Enable Octal DTR */
+#define SPINOR_REG_MXIC_DC_20		0x00	/* 20 dummy cycles */
+
 /* Status Register bits. */
 #define SR_WIP			BIT(0)	/* Write in progress */
 #define SR_WEL			BIT(1)	/* Write enable latch */
@@ -600,11 +600,11 @@ do {                                                                          \
 struct mallinfo {
   int arena;    /* total space allocated from system */
   int ordblks;  /* number of non-inuse chunks */
-  int smblks;   /* unused -- always zero */
+  int smblks;   /* number of cached small chunks */
   int hblks;    /* number of mmapped regions */
   int hblkhd;   /* total space in mmapped regions */
   int usmblks;  /* unused -- always zero */
-  int fsmblks;  /* unused -- always zero */
+  int fsmblks;  /* space in cached small chunks */
   int uordblks; /* total allocated space */
   int fordblks; /* total non-inuse space */
   int keepcost; /* top-most, releasable (via malloc_trim) space */
@@ -0,0 +1,25 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * NXP FlexSPI controller
+ */
+#ifndef __NXP_FSPI_H
+#define __NXP_FSPI_H
+
+#include <test/export.h>
+
+/* Number of 32-bit registers in one LUT sequence */
+#define NXP_FSPI_LUT_SIZE	4
+
+struct spi_mem_op;
+
+#ifdef CONFIG_UNIT_TEST
+/**
+ * nxp_fspi_lut_gen() - Encode a spi-mem operation as a LUT sequence
+ *
+ * @op: Operation to encode
+ * @lutval: Returns the sequence, NXP_FSPI_LUT_SIZE words
+ */
+TEST_STATIC void nxp_fspi_lut_gen(const struct spi_mem_op *op, u32 *lutval);
+#endif
+
+#endif /* __NXP_FSPI_H */
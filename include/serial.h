@@ -281,6 +281,10 @@ struct dm_serial_ops {
  * @buf:	Pointer to the RX buffer
  * @rd_ptr:	Read pointer in the RX buffer
  * @wr_ptr:	Write pointer in the RX buffer
+ *
+ * @tx_buf:	Pointer to the TX buffer, NULL if output is unbuffered
+ * @tx_rd_ptr:	Read pointer in the TX buffer
+ * @tx_wr_ptr:	Write pointer in the TX buffer
  */
 struct serial_dev_priv {
 	struct stdio_dev *sdev;
@@ -288,6 +292,10 @@ struct serial_dev_priv {
 	char *buf;
 	int rd_ptr;
 	int wr_ptr;
+
+	char *tx_buf;
+	int tx_rd_ptr;
+	int tx_wr_ptr;
 };
 
 /* Access the serial operations for a device */
@@ -354,4 +362,17 @@ void serial_puts(const char *str);
 int serial_getc(void);
 int serial_tstc(void);
 
+/**
+ * serial_flush() - Send all buffered output of the serial devices
+ *
+ * With CONFIG_SERIAL_TX_BUFFER, output is only passed to the UART as far as
+ * it can take it without waiting. This waits for the rest, as needed before
+ * handing over to an OS or resetting.
+ */
+#if CONFIG_IS_ENABLED(SERIAL_TX_BUFFER)
+void serial_flush(void);
+#else
+static inline void serial_flush(void) {}
+#endif
+
 #endif
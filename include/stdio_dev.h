@@ -9,6 +9,7 @@
 
 #include <stdio.h>
 #include <linux/list.h>
+#include <dm/uclass-id.h>
 
 /*
  * STDIO DEVICES
@@ -77,6 +78,16 @@ int stdio_init_tables(void);
  */
 int stdio_add_devices(void);
 
+/**
+ * stdio_probe_uclass() - Probe the devices of a uclass used for stdio
+ *
+ * Devices which are only probed on first use (see device_probe_on_demand())
+ * are skipped. Probe failures are reported but are not fatal.
+ *
+ * @id: Uclass whose devices to probe
+ */
+void stdio_probe_uclass(enum uclass_id id);
+
 /**
  * stdio_init() - Sets up stdio ready for use
  *
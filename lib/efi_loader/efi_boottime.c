@@ -15,6 +15,7 @@
 #include <log.h>
 #include <malloc.h>
 #include <pe.h>
+#include <serial.h>
 #include <time.h>
 #include <u-boot/crc.h>
 #include <usb.h>
@@ -2166,6 +2167,9 @@ static efi_status_t EFIAPI efi_exit_boot_services(efi_handle_t image_handle,
 			list_del(&evt->link);
 	}
 
+	/* The console is gone after this, send out what is buffered */
+	serial_flush();
+
 	if (!efi_st_keep_devices) {
 		bootm_disable_interrupts();
 		if (IS_ENABLED(CONFIG_USB_DEVICE))
@@ -13,7 +13,7 @@
 #include <watchdog.h>
 #include <asm/cache.h>
 #include <asm/global_data.h>
-#include <linux/list_sort.h>
+#include <linux/log2.h>
 #include <linux/sizes.h>
 
 DECLARE_GLOBAL_DATA_PTR;
@@ -46,9 +46,10 @@ void *efi_bounce_buffer;
  * @checksum:	checksum
  * @data:	allocated pool memory
  *
- * U-Boot services each UEFI AllocatePool() request as a separate
+ * U-Boot services each large UEFI AllocatePool() request as a separate
  * (multiple) page allocation. We have to track the number of pages
- * to be able to free the correct amount later.
+ * to be able to free the correct amount later. Small requests are
+ * served from shared pages, see EFI_POOL_SLAB.
  *
  * The checksum calculated in function checksum() is used in FreePool() to avoid
  * freeing memory not allocated by AllocatePool() and duplicate freeing.
@@ -62,6 +63,51 @@ struct efi_pool_allocation {
 	char data[] __aligned(ARCH_DMA_MINALIGN);
 };
 
+/*
+ * Small pool allocations are carved from single pages of the requested
+ * memory type instead of taking at least one page each. Chunk sizes
+ * (including the header) are powers of two from twice the header size,
+ * which depends on ARCH_DMA_MINALIGN, to 2 KiB. Freed chunks are kept on
+ * a list per memory type and size class for reuse. A page with no chunk
+ * in use goes back to the memory map, unless its chunks are the only
+ * free ones of their list.
+ *
+ * The num_pages field of a chunk's header holds EFI_POOL_SLAB, the
+ * memory type and the size class instead of a page count. The checksum
+ * of a free chunk is zero.
+ */
+#define EFI_POOL_SLAB			BIT_ULL(63)
+#define EFI_POOL_SLAB_TYPE_SHIFT	8
+#define EFI_POOL_SLAB_CLASS_MASK	0xff
+#define EFI_POOL_SLAB_MIN_SHIFT	\
+	(ilog2(sizeof(struct efi_pool_allocation)) + 1)
+#define EFI_POOL_SLAB_MAX_SHIFT		11
+#define EFI_POOL_SLAB_CLASSES	\
+	(EFI_POOL_SLAB_MAX_SHIFT - EFI_POOL_SLAB_MIN_SHIFT + 1)
+
+/**
+ * struct efi_pool_free - free chunk of a pool page, stored in its data area
+ *
+ * @link:	link in the free list of its memory type and size class
+ */
+struct efi_pool_free {
+	struct list_head link;
+};
+
+/**
+ * struct efi_pool_slab - free chunks of one memory type and size class
+ *
+ * @free:	list of free chunks, initialized on first use
+ * @num_free:	number of chunks in @free
+ */
+struct efi_pool_slab {
+	struct list_head free;
+	unsigned int num_free;
+};
+
+static struct efi_pool_slab efi_pool_slabs[EFI_MAX_MEMORY_TYPE]
+					  [EFI_POOL_SLAB_CLASSES];
+
 /**
  * checksum() - calculate checksum for memory allocated from pool
  *
@@ -78,72 +124,71 @@ static u64 checksum(struct efi_pool_allocation *alloc)
 	return ret;
 }
 
-/*
- * Sorts the memory list from highest address to lowest address
- *
- * When allocating memory we should always start from the highest
- * address chunk, so sort the memory list such that the first list
- * iterator gets the highest address and goes lower from there.
- */
-static int efi_mem_cmp(void *priv, struct list_head *a, struct list_head *b)
+static uint64_t desc_get_end(struct efi_mem_desc *desc)
 {
-	struct efi_mem_list *mema = list_entry(a, struct efi_mem_list, link);
-	struct efi_mem_list *memb = list_entry(b, struct efi_mem_list, link);
-
-	if (mema->desc.physical_start == memb->desc.physical_start)
-		return 0;
-	else if (mema->desc.physical_start < memb->desc.physical_start)
-		return 1;
-	else
-		return -1;
+	return desc->physical_start + (desc->num_pages << EFI_PAGE_SHIFT);
 }
 
-static uint64_t desc_get_end(struct efi_mem_desc *desc)
+/**
+ * efi_mem_can_merge() - check if two map entries can be merged
+ *
+ * @lower:	entry at the lower address
+ * @upper:	entry at the higher address
+ * Return:	true if @lower ends where @upper starts and both match
+ */
+static bool efi_mem_can_merge(struct efi_mem_desc *lower,
+			      struct efi_mem_desc *upper)
 {
-	return desc->physical_start + (desc->num_pages << EFI_PAGE_SHIFT);
+	return desc_get_end(lower) == upper->physical_start &&
+	       lower->type == upper->type &&
+	       lower->attribute == upper->attribute;
 }
 
-static void efi_mem_sort(void)
+/**
+ * efi_mem_insert() - add an entry to the memory map
+ *
+ * When allocating memory we should always start from the highest
+ * address chunk, so the memory list is kept sorted such that the first
+ * list iterator gets the highest address and goes lower from there.
+ *
+ * The new entry is inserted at its place and merged with its neighbours
+ * where possible. As the list is always kept merged, no other entries
+ * can become mergeable.
+ *
+ * @newmem:	entry to insert, must not overlap any entry of the list
+ */
+static void efi_mem_insert(struct efi_mem_list *newmem)
 {
-	struct list_head *lhandle;
-	struct efi_mem_list *prevmem = NULL;
-	bool merge_again = true;
-
-	list_sort(NULL, &efi_mem, efi_mem_cmp);
-
-	/* Now merge entries that can be merged */
-	while (merge_again) {
-		merge_again = false;
-		list_for_each(lhandle, &efi_mem) {
-			struct efi_mem_list *lmem;
-			struct efi_mem_desc *prev = &prevmem->desc;
-			struct efi_mem_desc *cur;
-			uint64_t pages;
-
-			lmem = list_entry(lhandle, struct efi_mem_list, link);
-			if (!prevmem) {
-				prevmem = lmem;
-				continue;
-			}
-
-			cur = &lmem->desc;
-
-			if ((desc_get_end(cur) == prev->physical_start) &&
-			    (prev->type == cur->type) &&
-			    (prev->attribute == cur->attribute)) {
-				/* There is an existing map before, reuse it */
-				pages = cur->num_pages;
-				prev->num_pages += pages;
-				prev->physical_start -= pages << EFI_PAGE_SHIFT;
-				prev->virtual_start -= pages << EFI_PAGE_SHIFT;
-				list_del(&lmem->link);
-				free(lmem);
-
-				merge_again = true;
-				break;
-			}
-
-			prevmem = lmem;
+	struct efi_mem_desc *desc = &newmem->desc;
+	struct efi_mem_list *lmem;
+
+	/* Find the first entry below the new one */
+	list_for_each_entry(lmem, &efi_mem, link) {
+		if (lmem->desc.physical_start < desc->physical_start)
+			break;
+	}
+	/* Insert before it, or at the end of the list */
+	list_add_tail(&newmem->link, &lmem->link);
+
+	if (newmem->link.next != &efi_mem) {
+		lmem = list_entry(newmem->link.next, struct efi_mem_list, link);
+		if (efi_mem_can_merge(&lmem->desc, desc)) {
+			desc->physical_start = lmem->desc.physical_start;
+			desc->virtual_start = lmem->desc.virtual_start;
+			desc->num_pages += lmem->desc.num_pages;
+			list_del(&lmem->link);
+			free(lmem);
+		}
+	}
+
+	if (newmem->link.prev != &efi_mem) {
+		lmem = list_entry(newmem->link.prev, struct efi_mem_list, link);
+		if (efi_mem_can_merge(desc, &lmem->desc)) {
+			lmem->desc.physical_start = desc->physical_start;
+			lmem->desc.virtual_start = desc->virtual_start;
+			lmem->desc.num_pages += desc->num_pages;
+			list_del(&newmem->link);
+			free(newmem);
 		}
 	}
 }
@@ -243,9 +288,8 @@ static efi_status_t efi_add_memory_map_pg(u64 start, u64 pages,
 					  int memory_type,
 					  bool overlap_only_ram)
 {
-	struct list_head *lhandle;
+	struct efi_mem_list *lmem, *next;
 	struct efi_mem_list *newlist;
-	bool carve_again;
 	uint64_t carved_pages = 0;
 	struct efi_event *evt;
 
@@ -278,46 +322,42 @@ static efi_status_t efi_add_memory_map_pg(u64 start, u64 pages,
 		break;
 	}
 
-	/* Add our new map */
-	do {
-		carve_again = false;
-		list_for_each(lhandle, &efi_mem) {
-			struct efi_mem_list *lmem;
-			s64 r;
+	/* Carve the new region out of the map, highest address first */
+	list_for_each_entry_safe(lmem, next, &efi_mem, link) {
+		s64 r;
+
+		/* All remaining entries are below the new region */
+		if (desc_get_end(&lmem->desc) <= start)
+			break;
 
-			lmem = list_entry(lhandle, struct efi_mem_list, link);
+		r = efi_mem_carve_out(lmem, &newlist->desc, overlap_only_ram);
+		if (r == EFI_CARVE_LOOP_AGAIN) {
+			/*
+			 * The entry was split, the upper part has been
+			 * inserted before it and starts at the new region.
+			 */
+			lmem = list_entry(lmem->link.prev, struct efi_mem_list,
+					  link);
 			r = efi_mem_carve_out(lmem, &newlist->desc,
 					      overlap_only_ram);
-			switch (r) {
-			case EFI_CARVE_OVERLAPS_NONRAM:
-				/*
-				 * The user requested to only have RAM overlaps,
-				 * but we hit a non-RAM region. Error out.
-				 */
-				return EFI_NO_MAPPING;
-			case EFI_CARVE_NO_OVERLAP:
-				/* Just ignore this list entry */
-				break;
-			case EFI_CARVE_LOOP_AGAIN:
-				/*
-				 * We split an entry, but need to loop through
-				 * the list again to actually carve it.
-				 */
-				carve_again = true;
-				break;
-			default:
-				/* We carved a number of pages */
-				carved_pages += r;
-				carve_again = true;
-				break;
-			}
-
-			if (carve_again) {
-				/* The list changed, we need to start over */
-				break;
-			}
 		}
-	} while (carve_again);
+
+		switch (r) {
+		case EFI_CARVE_OVERLAPS_NONRAM:
+			/*
+			 * The user requested to only have RAM overlaps,
+			 * but we hit a non-RAM region. Error out.
+			 */
+			return EFI_NO_MAPPING;
+		case EFI_CARVE_NO_OVERLAP:
+			/* Just ignore this list entry */
+			break;
+		default:
+			/* We carved a number of pages */
+			carved_pages += r;
+			break;
+		}
+	}
 
 	if (overlap_only_ram && (carved_pages != pages)) {
 		/*
@@ -327,11 +367,8 @@ static efi_status_t efi_add_memory_map_pg(u64 start, u64 pages,
 		return EFI_NO_MAPPING;
 	}
 
-	/* Add our new map */
-        list_add_tail(&newlist->link, &efi_mem);
-
-	/* And make sure memory is listed in descending order */
-	efi_mem_sort();
+	/* Add our new map in descending order */
+	efi_mem_insert(newlist);
 
 	/* Notify that the memory map was changed */
 	list_for_each_entry(evt, &efi_events, link) {
@@ -604,6 +641,126 @@ void *efi_alloc_aligned_pages(u64 len, int memory_type, size_t align)
 	return (void *)(uintptr_t)aligned_mem;
 }
 
+/**
+ * efi_pool_slab_class() - get size class for a small pool allocation
+ *
+ * @size:	number of bytes requested
+ * Return:	size class or -1 if the request is served with whole pages
+ */
+static int efi_pool_slab_class(efi_uintn_t size)
+{
+	int class;
+
+	if (size > (EFI_PAGE_SIZE / 2))
+		return -1;
+
+	size += sizeof(struct efi_pool_allocation);
+	for (class = 0; class < EFI_POOL_SLAB_CLASSES; class++) {
+		if (size <= (1UL << (EFI_POOL_SLAB_MIN_SHIFT + class)))
+			return class;
+	}
+
+	return -1;
+}
+
+/**
+ * efi_pool_slab_alloc() - allocate a chunk from a pool page
+ *
+ * @pool_type:	type of the pool from which memory is to be allocated
+ * @class:	size class from efi_pool_slab_class()
+ * @buffer:	allocated memory
+ * Return:	status code
+ */
+static efi_status_t efi_pool_slab_alloc(enum efi_memory_type pool_type,
+					int class, void **buffer)
+{
+	struct efi_pool_slab *slab = &efi_pool_slabs[pool_type][class];
+	struct efi_pool_allocation *alloc;
+	struct efi_pool_free *free;
+
+	if (!slab->free.next)
+		INIT_LIST_HEAD(&slab->free);
+
+	if (list_empty(&slab->free)) {
+		u64 chunk_size = 1ULL << (EFI_POOL_SLAB_MIN_SHIFT + class);
+		u64 addr, offset;
+		efi_status_t r;
+
+		r = efi_allocate_pages(EFI_ALLOCATE_ANY_PAGES, pool_type, 1,
+				       &addr);
+		if (r != EFI_SUCCESS)
+			return r;
+
+		for (offset = 0; offset < EFI_PAGE_SIZE; offset += chunk_size) {
+			alloc = (struct efi_pool_allocation *)(uintptr_t)
+				(addr + offset);
+			alloc->num_pages = EFI_POOL_SLAB | class |
+				((u64)pool_type << EFI_POOL_SLAB_TYPE_SHIFT);
+			alloc->checksum = 0;
+			free = (struct efi_pool_free *)alloc->data;
+			list_add_tail(&free->link, &slab->free);
+			slab->num_free++;
+		}
+	}
+
+	free = list_first_entry(&slab->free, struct efi_pool_free, link);
+	list_del(&free->link);
+	slab->num_free--;
+
+	alloc = container_of((void *)free, struct efi_pool_allocation, data);
+	alloc->checksum = checksum(alloc);
+	*buffer = alloc->data;
+
+	return EFI_SUCCESS;
+}
+
+/**
+ * efi_pool_slab_free() - put a chunk back on its free list
+ *
+ * The page of the chunk is returned to the memory map if none of its chunks
+ * is in use and there are free chunks of the same list in other pages.
+ *
+ * @alloc:	header of the chunk
+ * @type:	memory type of the chunk
+ * @class:	size class of the chunk
+ * Return:	status code
+ */
+static efi_status_t efi_pool_slab_free(struct efi_pool_allocation *alloc,
+				       u64 type, u64 class)
+{
+	struct efi_pool_slab *slab = &efi_pool_slabs[type][class];
+	u64 chunk_size = 1ULL << (EFI_POOL_SLAB_MIN_SHIFT + class);
+	u64 num_chunks = EFI_PAGE_SIZE / chunk_size;
+	u64 page = (uintptr_t)alloc & ~(u64)EFI_PAGE_MASK;
+	struct efi_pool_free *free;
+	u64 offset;
+
+	/* Avoid double free */
+	alloc->checksum = 0;
+
+	free = (struct efi_pool_free *)alloc->data;
+	list_add(&free->link, &slab->free);
+	slab->num_free++;
+
+	if (slab->num_free <= num_chunks)
+		return EFI_SUCCESS;
+
+	for (offset = 0; offset < EFI_PAGE_SIZE; offset += chunk_size) {
+		alloc = (struct efi_pool_allocation *)(uintptr_t)(page + offset);
+		if (alloc->checksum)
+			return EFI_SUCCESS;
+	}
+
+	for (offset = 0; offset < EFI_PAGE_SIZE; offset += chunk_size) {
+		alloc = (struct efi_pool_allocation *)(uintptr_t)(page + offset);
+		free = (struct efi_pool_free *)alloc->data;
+		list_del(&free->link);
+	}
+	slab->num_free -= num_chunks;
+
+	return efi_free_pages(page, 1);
+}
+
 /**
  * efi_allocate_pool - allocate memory from pool
  *
@@ -628,6 +785,13 @@ efi_status_t efi_allocate_pool(enum efi_memory_type pool_type, efi_uintn_t size,
 		return EFI_SUCCESS;
 	}
 
+	if (pool_type < EFI_MAX_MEMORY_TYPE) {
+		int class = efi_pool_slab_class(size);
+
+		if (class >= 0)
+			return efi_pool_slab_alloc(pool_type, class, buffer);
+	}
+
 	r = efi_allocate_pages(EFI_ALLOCATE_ANY_PAGES, pool_type, num_pages,
 			       &addr);
 	if (r == EFI_SUCCESS) {
@@ -654,24 +818,45 @@ efi_status_t efi_free_pool(void *buffer)
 	if (!buffer)
 		return EFI_INVALID_PARAMETER;
 
+	/* The page of a freed chunk may be back in the memory map */
 	ret = efi_check_allocated((uintptr_t)buffer, true);
 	if (ret != EFI_SUCCESS)
-		return ret;
+		return EFI_INVALID_PARAMETER;
 
 	alloc = container_of(buffer, struct efi_pool_allocation, data);
 
 	/* Check that this memory was allocated by efi_allocate_pool() */
-	if (((uintptr_t)alloc & EFI_PAGE_MASK) ||
-	    alloc->checksum != checksum(alloc)) {
-		printf("%s: illegal free 0x%p\n", __func__, buffer);
-		return EFI_INVALID_PARAMETER;
+	if (((uintptr_t)alloc & ((1UL << EFI_POOL_SLAB_MIN_SHIFT) - 1)) ||
+	    alloc->checksum != checksum(alloc))
+		goto illegal;
+
+	if (alloc->num_pages & EFI_POOL_SLAB) {
+		u64 type = (alloc->num_pages & ~EFI_POOL_SLAB) >>
+			   EFI_POOL_SLAB_TYPE_SHIFT;
+		u64 class = alloc->num_pages & EFI_POOL_SLAB_CLASS_MASK;
+
+		if (type >= EFI_MAX_MEMORY_TYPE ||
+		    class >= EFI_POOL_SLAB_CLASSES ||
+		    ((uintptr_t)alloc &
+		     ((1UL << (EFI_POOL_SLAB_MIN_SHIFT + class)) - 1)))
+			goto illegal;
+
+		return efi_pool_slab_free(alloc, type, class);
 	}
+
+	if ((uintptr_t)alloc & EFI_PAGE_MASK)
+		goto illegal;
+
 	/* Avoid double free */
 	alloc->checksum = 0;
 
 	ret = efi_free_pages((uintptr_t)alloc, alloc->num_pages);
 
 	return ret;
+
+illegal:
+	printf("%s: illegal free 0x%p\n", __func__, buffer);
+	return EFI_INVALID_PARAMETER;
 }
 
 /*
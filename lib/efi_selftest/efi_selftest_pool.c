@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * efi_selftest_pool
+ *
+ * This unit test checks the following boottime services:
+ * AllocatePool, FreePool
+ *
+ * Many small blocks of different sizes are allocated, checked for
+ * alignment and overlap, freed and allocated again, as done by boot
+ * loaders creating device paths and strings.
+ */
+
+#include <efi_selftest.h>
+
+#define EFI_ST_NUM_ALLOCS 1024
+#define EFI_ST_ROUNDS 4
+
+static struct efi_boot_services *boottime;
+static u8 **buffers;
+
+/**
+ * setup() - setup unit test
+ *
+ * @handle:	handle of the loaded image
+ * @systable:	system table
+ * Return:	EFI_ST_SUCCESS for success
+ */
+static int setup(const efi_handle_t handle,
+		 const struct efi_system_table *systable)
+{
+	efi_status_t ret;
+
+	boottime = systable->boottime;
+
+	ret = boottime->allocate_pool(EFI_LOADER_DATA,
+				      EFI_ST_NUM_ALLOCS * sizeof(*buffers),
+				      (void **)&buffers);
+	if (ret != EFI_SUCCESS) {
+		efi_st_error("AllocatePool did not return EFI_SUCCESS\n");
+		return EFI_ST_FAILURE;
+	}
+
+	return EFI_ST_SUCCESS;
+}
+
+/**
+ * teardown() - tear down unit test
+ *
+ * Return:	EFI_ST_SUCCESS for success
+ */
+static int teardown(void)
+{
+	efi_status_t ret;
+
+	if (!buffers)
+		return EFI_ST_SUCCESS;
+
+	ret = boottime->free_pool(buffers);
+	buffers = NULL;
+	if (ret != EFI_SUCCESS) {
+		efi_st_error("FreePool did not return EFI_SUCCESS\n");
+		return EFI_ST_FAILURE;
+	}
+
+	return EFI_ST_SUCCESS;
+}
+
+/**
+ * alloc_size() - get size of an allocation
+ *
+ * @i:		number of the allocation
+ * Return:	size in bytes, between 1 and 3000
+ */
+static efi_uintn_t alloc_size(unsigned int i)
+{
+	return 1 + (i * 37) % 3000;
+}
+
+/*
+ * execute() - execute unit test
+ *
+ * Return:	EFI_ST_SUCCESS for success
+ */
+static int execute(void)
+{
+	unsigned int round, i;
+	efi_status_t ret;
+
+	for (round = 0; round < EFI_ST_ROUNDS; round++) {
+		for (i = 0; i < EFI_ST_NUM_ALLOCS; i++) {
+			enum efi_memory_type type = i & 1 ?
+				EFI_BOOT_SERVICES_DATA : EFI_LOADER_DATA;
+
+			ret = boottime->allocate_pool(type, alloc_size(i),
+						      (void **)&buffers[i]);
+			if (ret != EFI_SUCCESS) {
+				efi_st_error("AllocatePool did not return EFI_SUCCESS\n");
+				return EFI_ST_FAILURE;
+			}
+			if ((uintptr_t)buffers[i] & 7) {
+				efi_st_error("Pool memory is not 8 byte aligned\n");
+				return EFI_ST_FAILURE;
+			}
+			/* Mark the block so that overlaps are detected */
+			memset(buffers[i], (u8)i, alloc_size(i));
+		}
+
+		for (i = 0; i < EFI_ST_NUM_ALLOCS; i++) {
+			efi_uintn_t size = alloc_size(i);
+
+			if (buffers[i][0] != (u8)i ||
+			    buffers[i][size - 1] != (u8)i) {
+				efi_st_error("Pool allocations overlap\n");
+				return EFI_ST_FAILURE;
+			}
+		}
+
+		/* Free every other block first to mix free and used memory */
+		for (i = 0; i < EFI_ST_NUM_ALLOCS; i += 2) {
+			ret = boottime->free_pool(buffers[i]);
+			if (ret != EFI_SUCCESS) {
+				efi_st_error("FreePool did not return EFI_SUCCESS\n");
+				return EFI_ST_FAILURE;
+			}
+		}
+		for (i = 1; i < EFI_ST_NUM_ALLOCS; i += 2) {
+			ret = boottime->free_pool(buffers[i]);
+			if (ret != EFI_SUCCESS) {
+				efi_st_error("FreePool did not return EFI_SUCCESS\n");
+				return EFI_ST_FAILURE;
+			}
+		}
+	}
+
+	/* A second free of the same block must be rejected */
+	ret = boottime->free_pool(buffers[0]);
+	if (ret != EFI_INVALID_PARAMETER) {
+		efi_st_error("Duplicate FreePool was not rejected\n");
+		return EFI_ST_FAILURE;
+	}
+
+	return EFI_ST_SUCCESS;
+}
+
+EFI_UNIT_TEST(pool) = {
+	.name = "pool",
+	.phase = EFI_EXECUTE_BEFORE_BOOTTIME_EXIT,
+	.setup = setup,
+	.execute = execute,
+	.teardown = teardown,
+};
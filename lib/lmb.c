@@ -83,15 +83,30 @@ static long lmb_regions_adjacent(struct lmb_region *rgn, unsigned long r1,
 	return lmb_addrs_adjacent(base1, size1, base2, size2);
 }
 
-static void lmb_remove_region(struct lmb_region *rgn, unsigned long r)
+/*
+ * Return the index of the first region that ends at or above @addr, or
+ * rgn->cnt if there is none. The regions are sorted and do not overlap, so
+ * this is the only region that can contain @addr.
+ */
+static unsigned long lmb_find_region(struct lmb_region *rgn, phys_addr_t addr)
 {
-	unsigned long i;
-
-	for (i = r; i < rgn->cnt - 1; i++) {
-		rgn->region[i].base = rgn->region[i + 1].base;
-		rgn->region[i].size = rgn->region[i + 1].size;
-		rgn->region[i].flags = rgn->region[i + 1].flags;
+	unsigned long lo = 0, hi = rgn->cnt, mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (rgn->region[mid].base + rgn->region[mid].size - 1 < addr)
+			lo = mid + 1;
+		else
+			hi = mid;
 	}
+
+	return lo;
+}
+
+static void lmb_remove_region(struct lmb_region *rgn, unsigned long r)
+{
+	memmove(&rgn->region[r], &rgn->region[r + 1],
+		(rgn->cnt - r - 1) * sizeof(rgn->region[0]));
 	rgn->cnt--;
 }
 
@@ -192,83 +207,54 @@ void lmb_init_and_reserve_range(struct lmb *lmb, phys_addr_t base,
 static long lmb_add_region_flags(struct lmb_region *rgn, phys_addr_t base,
 				 phys_size_t size, enum lmb_flags flags)
 {
-	unsigned long coalesced = 0;
-	long adjacent, i;
+	struct lmb_property *next;
+	unsigned long i;
 
-	if (rgn->cnt == 0) {
-		rgn->region[0].base = base;
-		rgn->region[0].size = size;
-		rgn->region[0].flags = flags;
-		rgn->cnt = 1;
-		return 0;
+	/* Regions before i end below the new one */
+	i = lmb_find_region(rgn, base);
+	next = i < rgn->cnt ? &rgn->region[i] : NULL;
+
+	if (next && next->base == base && next->size == size) {
+		if (flags == next->flags)
+			/* Already have this region, so we're done */
+			return 0;
+		else
+			return -1; /* regions with new flags */
 	}
 
-	/* First try and coalesce this LMB with another. */
-	for (i = 0; i < rgn->cnt; i++) {
-		phys_addr_t rgnbase = rgn->region[i].base;
-		phys_size_t rgnsize = rgn->region[i].size;
-		phys_size_t rgnflags = rgn->region[i].flags;
-
-		if (rgnbase == base && rgnsize == size) {
-			if (flags == rgnflags)
-				/* Already have this region, so we're done */
-				return 0;
-			else
-				return -1; /* regions with new flags */
-		}
-
-		adjacent = lmb_addrs_adjacent(base, size, rgnbase, rgnsize);
-		if (adjacent > 0) {
-			if (flags != rgnflags)
-				break;
-			rgn->region[i].base -= size;
-			rgn->region[i].size += size;
-			coalesced++;
-			break;
-		} else if (adjacent < 0) {
-			if (flags != rgnflags)
-				break;
-			rgn->region[i].size += size;
-			coalesced++;
-			break;
-		} else if (lmb_addrs_overlap(base, size, rgnbase, rgnsize)) {
-			/* regions overlap */
-			return -2;
+	if (next && lmb_addrs_overlap(base, size, next->base, next->size))
+		/* regions overlap */
+		return -2;
+
+	/* First try and coalesce this LMB with its neighbours. */
+	if (i > 0 && lmb_addrs_adjacent(base, size, rgn->region[i - 1].base,
+					rgn->region[i - 1].size) < 0 &&
+	    flags == rgn->region[i - 1].flags) {
+		rgn->region[i - 1].size += size;
+		if (next && lmb_regions_adjacent(rgn, i - 1, i) > 0 &&
+		    flags == next->flags) {
+			lmb_coalesce_regions(rgn, i - 1, i);
+			return 2;
 		}
+		return 1;
 	}
 
-	if ((i < rgn->cnt - 1) && lmb_regions_adjacent(rgn, i, i + 1)) {
-		if (rgn->region[i].flags == rgn->region[i + 1].flags) {
-			lmb_coalesce_regions(rgn, i, i + 1);
-			coalesced++;
-		}
+	if (next && lmb_addrs_adjacent(base, size, next->base, next->size) > 0 &&
+	    flags == next->flags) {
+		next->base -= size;
+		next->size += size;
+		return 1;
 	}
 
-	if (coalesced)
-		return coalesced;
 	if (rgn->cnt >= rgn->max)
 		return -1;
 
 	/* Couldn't coalesce the LMB, so add it to the sorted table. */
-	for (i = rgn->cnt-1; i >= 0; i--) {
-		if (base < rgn->region[i].base) {
-			rgn->region[i + 1].base = rgn->region[i].base;
-			rgn->region[i + 1].size = rgn->region[i].size;
-			rgn->region[i + 1].flags = rgn->region[i].flags;
-		} else {
-			rgn->region[i + 1].base = base;
-			rgn->region[i + 1].size = size;
-			rgn->region[i + 1].flags = flags;
-			break;
-		}
-	}
-
-	if (base < rgn->region[0].base) {
-		rgn->region[0].base = base;
-		rgn->region[0].size = size;
-		rgn->region[0].flags = flags;
-	}
-
+	memmove(&rgn->region[i + 1], &rgn->region[i],
+		(rgn->cnt - i) * sizeof(rgn->region[0]));
+	rgn->region[i].base = base;
+	rgn->region[i].size = size;
+	rgn->region[i].flags = flags;
 	rgn->cnt++;
 
 	return 0;
@@ -295,21 +281,18 @@ long lmb_free(struct lmb *lmb, phys_addr_t base, phys_size_t size)
 	phys_addr_t end = base + size - 1;
 	int i;
 
-	rgnbegin = rgnend = 0; /* supress gcc warnings */
-
 	/* Find the region where (base, size) belongs to */
-	for (i = 0; i < rgn->cnt; i++) {
-		rgnbegin = rgn->region[i].base;
-		rgnend = rgnbegin + rgn->region[i].size - 1;
-
-		if ((rgnbegin <= base) && (end <= rgnend))
-			break;
-	}
+	i = lmb_find_region(rgn, base);
 
 	/* Didn't find the region */
 	if (i == rgn->cnt)
 		return -1;
 
+	rgnbegin = rgn->region[i].base;
+	rgnend = rgnbegin + rgn->region[i].size - 1;
+	if (rgnbegin > base || end > rgnend)
+		return -1;
+
 	/* Check to see if we are removing entire region */
 	if ((rgnbegin == base) && (rgnend == end)) {
 		lmb_remove_region(rgn, i);
@@ -354,16 +337,13 @@ long lmb_reserve(struct lmb *lmb, phys_addr_t base, phys_size_t size)
 static long lmb_overlaps_region(struct lmb_region *rgn, phys_addr_t base,
 				phys_size_t size)
 {
-	unsigned long i;
+	unsigned long i = lmb_find_region(rgn, base);
 
-	for (i = 0; i < rgn->cnt; i++) {
-		phys_addr_t rgnbase = rgn->region[i].base;
-		phys_size_t rgnsize = rgn->region[i].size;
-		if (lmb_addrs_overlap(base, size, rgnbase, rgnsize))
-			break;
-	}
+	if (i < rgn->cnt && lmb_addrs_overlap(base, size, rgn->region[i].base,
+					      rgn->region[i].size))
+		return i;
 
-	return (i < rgn->cnt) ? i : -1;
+	return -1;
 }
 
 long lmb_reserve_overlap(struct lmb *lmb, phys_addr_t base, phys_size_t size,
@@ -496,22 +476,20 @@ phys_addr_t lmb_alloc_addr(struct lmb *lmb, phys_addr_t base, phys_size_t size)
 /* Return number of bytes from a given address that are free */
 phys_size_t lmb_get_free_size(struct lmb *lmb, phys_addr_t addr)
 {
-	int i;
+	unsigned long i;
 	long rgn;
 
 	/* check if the requested address is in the memory regions */
 	rgn = lmb_overlaps_region(&lmb->memory, addr, 1);
 	if (rgn >= 0) {
-		for (i = 0; i < lmb->reserved.cnt; i++) {
+		i = lmb_find_region(&lmb->reserved, addr);
+		if (i < lmb->reserved.cnt) {
 			if (addr < lmb->reserved.region[i].base) {
 				/* first reserved range > requested address */
 				return lmb->reserved.region[i].base - addr;
 			}
-			if (lmb->reserved.region[i].base +
-			    lmb->reserved.region[i].size > addr) {
-				/* requested addr is in this reserved range */
-				return 0;
-			}
+			/* requested addr is in this reserved range */
+			return 0;
 		}
 		/* if we come here: no reserved ranges above requested addr */
 		return lmb->memory.region[lmb->memory.cnt - 1].base +
@@ -522,14 +500,10 @@ phys_size_t lmb_get_free_size(struct lmb *lmb, phys_addr_t addr)
 
 int lmb_is_reserved_flags(struct lmb *lmb, phys_addr_t addr, int flags)
 {
-	int i;
+	unsigned long i = lmb_find_region(&lmb->reserved, addr);
 
-	for (i = 0; i < lmb->reserved.cnt; i++) {
-		phys_addr_t upper = lmb->reserved.region[i].base +
-			lmb->reserved.region[i].size - 1;
-		if ((addr >= lmb->reserved.region[i].base) && (addr <= upper))
-			return (lmb->reserved.region[i].flags & flags) == flags;
-	}
+	if (i < lmb->reserved.cnt && addr >= lmb->reserved.region[i].base)
+		return (lmb->reserved.region[i].flags & flags) == flags;
 	return 0;
 }
 
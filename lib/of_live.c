@@ -295,6 +295,8 @@ static int unflatten_device_tree(const void *blob,
 
 	/* Allocate memory for the expanded device tree */
 	mem = malloc(size + 4);
+	if (!mem)
+		return -ENOMEM;
 	memset(mem, '\0', size);
 
 	*(__be32 *)(mem + size) = cpu_to_be32(0xdeadbeef);
@@ -325,6 +327,11 @@ int of_live_build(const void *fdt_blob, struct device_node **rootp)
 		debug("Failed to create live tree: err=%d\n", ret);
 		return ret;
 	}
+	ret = of_phandle_cache_init();
+	if (ret) {
+		debug("Failed to set up phandle cache: err=%d\n", ret);
+		return ret;
+	}
 	ret = of_alias_scan();
 	if (ret) {
 		debug("Failed to scan live tree aliases: err=%d\n", ret);
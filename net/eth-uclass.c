@@ -414,9 +414,56 @@ int eth_rx(void)
 	return ret;
 }
 
+static bool eth_dev_get_mac_address(struct udevice *dev, u8 mac[ARP_HLEN])
+{
+#if CONFIG_IS_ENABLED(OF_CONTROL)
+	const uint8_t *p;
+
+	p = dev_read_u8_array_ptr(dev, "mac-address", ARP_HLEN);
+	if (!p)
+		p = dev_read_u8_array_ptr(dev, "local-mac-address", ARP_HLEN);
+
+	if (!p)
+		return false;
+
+	memcpy(mac, p, ARP_HLEN);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+ * A device which is only probed on first use must still provide its MAC
+ * address, so that Linux gets it through the device tree fixup. Take it from
+ * the environment or the device tree if possible. Only the driver can read it
+ * from ROM, so return false if the device has to be probed after all.
+ */
+static bool eth_dev_defer_probe(struct udevice *dev)
+{
+	u8 mac[ARP_HLEN];
+
+	if (!device_probe_on_demand(dev))
+		return false;
+
+	if (eth_env_get_enetaddr_by_index("eth", dev_seq(dev), mac))
+		return true;
+
+	if (eth_dev_get_mac_address(dev, mac) && is_valid_ethaddr(mac)) {
+		eth_env_set_enetaddr_by_index("eth", dev_seq(dev), mac);
+		return true;
+	}
+
+	log_debug("Probing %s for its MAC address\n", dev->name);
+
+	return false;
+}
+
 int eth_initialize(void)
 {
 	int num_devices = 0;
+	int num_deferred = 0;
 	struct udevice *dev;
 
 	eth_common_init();
@@ -427,7 +474,7 @@ int eth_initialize(void)
 	 * This is accomplished by attempting to probe each device and calling
 	 * their write_hwaddr() operation.
 	 */
-	uclass_first_device_check(UCLASS_ETH, &dev);
+	uclass_find_first_device(UCLASS_ETH, &dev);
 	if (!dev) {
 		log_err("No ethernet found.\n");
 		bootstage_error(BOOTSTAGE_ID_NET_ETH_START);
@@ -435,6 +482,7 @@ int eth_initialize(void)
 		char *ethprime = env_get("ethprime");
 		struct udevice *prime_dev = NULL;
 
+		/* This probes all devices, including those probed on demand */
 		if (ethprime)
 			prime_dev = eth_get_dev_by_name(ethprime);
 		if (prime_dev) {
@@ -446,8 +494,23 @@ int eth_initialize(void)
 
 		bootstage_mark(BOOTSTAGE_ID_NET_ETH_INIT);
 		do {
+			/* probed by eth_init() when the device is used */
+			if (!device_active(dev) && eth_dev_defer_probe(dev)) {
+				if (num_devices + num_deferred)
+					printf(", ");
+
+				printf("eth%d: %s [ON DEMAND]", dev_seq(dev),
+				       dev->name);
+				num_deferred++;
+				uclass_find_next_device(&dev);
+				continue;
+			}
+
+			/* devices which fail to probe are skipped below */
+			device_probe(dev);
+
 			if (device_active(dev)) {
-				if (num_devices)
+				if (num_devices + num_deferred)
 					printf(", ");
 
 				printf("eth%d: %s", dev_seq(dev), dev->name);
@@ -460,10 +523,10 @@ int eth_initialize(void)
 
 			if (device_active(dev))
 				num_devices++;
-			uclass_next_device_check(&dev);
+			uclass_find_next_device(&dev);
 		} while (dev);
 
-		if (!num_devices)
+		if (!num_devices && !num_deferred)
 			log_err("No ethernet found.\n");
 		putc('\n');
 	}
@@ -495,26 +558,6 @@ static int eth_pre_unbind(struct udevice *dev)
 	return 0;
 }
 
-static bool eth_dev_get_mac_address(struct udevice *dev, u8 mac[ARP_HLEN])
-{
-#if CONFIG_IS_ENABLED(OF_CONTROL)
-	const uint8_t *p;
-
-	p = dev_read_u8_array_ptr(dev, "mac-address", ARP_HLEN);
-	if (!p)
-		p = dev_read_u8_array_ptr(dev, "local-mac-address", ARP_HLEN);
-
-	if (!p)
-		return false;
-
-	memcpy(mac, p, ARP_HLEN);
-
-	return true;
-#else
-	return false;
-#endif
-}
-
 static int eth_post_probe(struct udevice *dev)
 {
 	struct eth_device_priv *priv = dev_get_uclass_priv(dev);
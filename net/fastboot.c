@@ -22,8 +22,17 @@ struct __packed fastboot_header {
 	unsigned short seq;
 };
 
-#define PACKET_SIZE 1024
-#define DATA_SIZE (PACKET_SIZE - sizeof(struct fastboot_header))
+/*
+ * The host uses the smaller of its own and our packet size, so offer as much
+ * as we can receive: a whole reassembled datagram, but at least one Ethernet
+ * frame. This is max(CONFIG_NET_MAXDEFRAG, ETH_DATA_LEN), spelled out for the
+ * preprocessor since last_packet[] needs a constant size.
+ */
+#if defined(CONFIG_IP_DEFRAG) && CONFIG_NET_MAXDEFRAG > ETH_DATA_LEN
+#define PACKET_SIZE (CONFIG_NET_MAXDEFRAG - IP_UDP_HDR_SIZE)
+#else
+#define PACKET_SIZE (ETH_DATA_LEN - IP_UDP_HDR_SIZE)
+#endif
 
 /* Sequence number sent for every packet */
 static unsigned short sequence_number = 1;
@@ -176,9 +185,11 @@ static void fastboot_send(struct fastboot_header header, char *fastboot_data,
 						       response);
 			}
 		} else if (!pending_command) {
-			strlcpy(command, fastboot_data,
-				min((size_t)fastboot_data_len + 1,
-				    sizeof(command)));
+			size_t cmd_len = min_t(size_t, fastboot_data_len,
+					       sizeof(command) - 1);
+
+			memcpy(command, fastboot_data, cmd_len);
+			command[cmd_len] = '\0';
 			pending_command = true;
 		} else {
 			cmd = fastboot_handle_command(command, response);
@@ -261,7 +272,7 @@ static void fastboot_handler(uchar *packet, unsigned int dport,
 			     unsigned int len)
 {
 	struct fastboot_header header;
-	char fastboot_data[DATA_SIZE] = {0};
+	char *fastboot_data;
 	unsigned int fastboot_data_len = 0;
 
 	if (dport != fastboot_our_port)
@@ -277,6 +288,8 @@ static void fastboot_handler(uchar *packet, unsigned int dport,
 	header.seq = ntohs(header.seq);
 	packet += sizeof(header);
 	len -= sizeof(header);
+	/* Hand the data on in place, downloads are copied only once */
+	fastboot_data = (char *)packet;
 
 	switch (header.id) {
 	case FASTBOOT_QUERY:
@@ -285,8 +298,6 @@ static void fastboot_handler(uchar *packet, unsigned int dport,
 	case FASTBOOT_INIT:
 	case FASTBOOT_FASTBOOT:
 		fastboot_data_len = len;
-		if (len > 0)
-			memcpy(fastboot_data, packet, len);
 		if (header.seq == sequence_number) {
 			fastboot_send(header, fastboot_data,
 				      fastboot_data_len, 0);
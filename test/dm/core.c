@@ -11,6 +11,7 @@
 #include <fdtdec.h>
 #include <log.h>
 #include <malloc.h>
+#include <time.h>
 #include <asm/global_data.h>
 #include <dm/device-internal.h>
 #include <dm/root.h>
@@ -1258,3 +1259,39 @@ static int dm_test_get_stats(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_get_stats, UT_TESTF_SCAN_FDT);
+
+/* Make sure each device with a node can be found by it, in any uclass */
+static int dm_test_find_by_ofnode(struct unit_test_state *uts)
+{
+	struct udevice *dev, *found;
+	struct uclass *uc;
+	ofnode node;
+	ulong start;
+	int count = 0;
+
+	start = timer_get_us();
+	list_for_each_entry(uc, gd->uclass_root, sibling_node) {
+		list_for_each_entry(dev, &uc->dev_head, uclass_node) {
+			node = dev_ofnode(dev);
+			if (!ofnode_valid(node))
+				continue;
+			ut_assertok(uclass_find_device_by_ofnode(uc->uc_drv->id,
+								 node, &found));
+			ut_asserteq(uc->uc_drv->id, device_get_uclass_id(found));
+			ut_assert(ofnode_equal(node, dev_ofnode(found)));
+			count++;
+		}
+	}
+	printf("%d lookups in %lu us\n", count, timer_get_us() - start);
+
+	/* An unbound device must not be found any more */
+	node = ofnode_path("/a-test");
+	ut_assertok(uclass_find_device_by_ofnode(UCLASS_TEST_FDT, node, &dev));
+	ut_assertok(device_unbind(dev));
+	ut_asserteq(-ENODEV, uclass_find_device_by_ofnode(UCLASS_TEST_FDT, node,
+							  &dev));
+	ut_assertnull(dev);
+
+	return 0;
+}
+DM_TEST(dm_test_find_by_ofnode, UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for the NXP FlexSPI LUT generation
+ */
+
+#include <common.h>
+#include <nxp_fspi.h>
+#include <spi-mem.h>
+#include <dm/test.h>
+#include <test/ut.h>
+
+/* Test the sequence for a 1S-1S-1S fast read */
+static int dm_test_nxp_fspi_lut_sdr(struct unit_test_state *uts)
+{
+	struct spi_mem_op op = SPI_MEM_OP(SPI_MEM_OP_CMD(0x0b, 1),
+					  SPI_MEM_OP_ADDR(3, 0, 1),
+					  SPI_MEM_OP_DUMMY(1, 1),
+					  SPI_MEM_OP_DATA_IN(256, NULL, 1));
+	u32 lut[NXP_FSPI_LUT_SIZE];
+
+	nxp_fspi_lut_gen(&op, lut);
+	/* CMD 0x0b, ADDR 24 bits, DUMMY 8 cycles, READ, STOP */
+	ut_asserteq(0x0818040b, lut[0]);
+	ut_asserteq(0x24003008, lut[1]);
+	ut_asserteq(0, lut[2]);
+	ut_asserteq(0, lut[3]);
+
+	/* A command without address and data is followed by STOP */
+	op = (struct spi_mem_op)SPI_MEM_OP(SPI_MEM_OP_CMD(0x06, 1),
+					   SPI_MEM_OP_NO_ADDR,
+					   SPI_MEM_OP_NO_DUMMY,
+					   SPI_MEM_OP_NO_DATA);
+	nxp_fspi_lut_gen(&op, lut);
+	ut_asserteq(0x0406, lut[0]);
+	ut_asserteq(0, lut[1]);
+
+	return 0;
+}
+DM_TEST(dm_test_nxp_fspi_lut_sdr, 0);
+
+/* Test the sequences for 8D-8D-8D reads and page programs */
+static int dm_test_nxp_fspi_lut_dtr(struct unit_test_state *uts)
+{
+	struct spi_mem_op op = SPI_MEM_OP(SPI_MEM_OP_CMD(0xee11, 8),
+					  SPI_MEM_OP_ADDR(4, 0, 8),
+					  SPI_MEM_OP_DUMMY(40, 8),
+					  SPI_MEM_OP_DATA_IN(256, NULL, 8));
+	u32 lut[NXP_FSPI_LUT_SIZE];
+
+	op.cmd.nbytes = 2;
+	op.cmd.dtr = true;
+	op.addr.dtr = true;
+	op.dummy.dtr = true;
+	op.data.dtr = true;
+
+	nxp_fspi_lut_gen(&op, lut);
+	/* CMD_DDR 0xee, CMD_DDR 0x11, ADDR_DDR 32 bits, DUMMY_DDR, READ_DDR */
+	ut_asserteq(0x871187ee, lut[0]);
+	ut_asserteq(0xb3288b20, lut[1]);
+	ut_asserteq(0x0000a700, lut[2]);
+	ut_asserteq(0, lut[3]);
+
+	op.cmd.opcode = 0x12ed;
+	op.dummy.nbytes = 0;
+	op.data.dir = SPI_MEM_DATA_OUT;
+
+	nxp_fspi_lut_gen(&op, lut);
+	/* CMD_DDR 0x12, CMD_DDR 0xed, ADDR_DDR 32 bits, WRITE_DDR, STOP */
+	ut_asserteq(0x87ed8712, lut[0]);
+	ut_asserteq(0xa3008b20, lut[1]);
+	ut_asserteq(0, lut[2]);
+	ut_asserteq(0, lut[3]);
+
+	return 0;
+}
+DM_TEST(dm_test_nxp_fspi_lut_dtr, 0);
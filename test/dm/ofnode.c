@@ -3,6 +3,7 @@
 #include <common.h>
 #include <dm.h>
 #include <log.h>
+#include <dm/of_access.h>
 #include <dm/of_extra.h>
 #include <dm/test.h>
 #include <test/test.h>
@@ -35,6 +36,24 @@ static int dm_test_ofnode_get_by_phandle(struct unit_test_state *uts)
 }
 DM_TEST(dm_test_ofnode_get_by_phandle, UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
 
+static int dm_test_ofnode_phandle_cache(struct unit_test_state *uts)
+{
+	struct device_node *np;
+	int count = 0;
+
+	/* every node must be found by its phandle, cached or not */
+	for_each_of_allnodes(np) {
+		if (!np->phandle)
+			continue;
+		ut_asserteq_ptr(np, of_find_node_by_phandle(np->phandle));
+		count++;
+	}
+	ut_assert(count > 0);
+
+	return 0;
+}
+DM_TEST(dm_test_ofnode_phandle_cache, UT_TESTF_SCAN_FDT | UT_TESTF_LIVE_TREE);
+
 static int dm_test_ofnode_by_prop_value(struct unit_test_state *uts)
 {
 	const char propname[] = "compatible";
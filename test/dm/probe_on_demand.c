@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Test for devices which are only probed on first use
+ */
+
+#include <common.h>
+#include <dm.h>
+#include <env.h>
+#include <malloc.h>
+#include <net.h>
+#include <stdio_dev.h>
+#include <dm/device-internal.h>
+#include <dm/lists.h>
+#include <dm/root.h>
+#include <dm/test.h>
+#include <dm/uclass-internal.h>
+#include <test/test.h>
+#include <test/ut.h>
+
+/* Start-up code must leave the device alone until it is looked up */
+static int dm_test_probe_on_demand(struct unit_test_state *uts)
+{
+	struct udevice *dev, *other, *found;
+	ofnode node;
+
+	node = ofnode_path("/eth-on-demand");
+	ut_assert(ofnode_valid(node));
+	ut_assertok(lists_bind_fdt(dm_root(), node, &dev, NULL, false));
+	ut_assertnonnull(dev);
+	ut_assert(device_probe_on_demand(dev));
+
+	ut_assertok(uclass_find_device_by_name(UCLASS_ETH, "eth@10002000",
+					       &other));
+	ut_assert(!device_probe_on_demand(other));
+
+	stdio_probe_uclass(UCLASS_ETH);
+	ut_assert(device_active(other));
+	ut_assert(!device_active(dev));
+
+	eth_initialize();
+	ut_assert(!device_active(dev));
+
+	for (uclass_first_device_check(UCLASS_ETH, &found);
+	     found && found != dev;
+	     uclass_next_device_check(&found))
+		;
+	ut_asserteq_ptr(dev, found);
+	ut_assert(device_active(dev));
+
+	return 0;
+}
+DM_TEST(dm_test_probe_on_demand, UT_TESTF_SCAN_FDT);
+
+/* The MAC address of a device probed on demand must still reach Linux */
+static int dm_test_probe_on_demand_hwaddr(struct unit_test_state *uts)
+{
+	struct udevice *dev;
+	char name[16], *old;
+	ofnode node;
+
+	node = ofnode_path("/eth-on-demand");
+	ut_assertok(lists_bind_fdt(dm_root(), node, &dev, NULL, false));
+	snprintf(name, sizeof(name), "eth%daddr", dev_seq(dev));
+	old = env_get(name) ? strdup(env_get(name)) : NULL;
+
+	/* Must disable access protection before clearing the address */
+	env_set(".flags", name);
+	env_set(name, NULL);
+
+	/* Taken from the device tree, without probing */
+	eth_initialize();
+	ut_assert(!device_active(dev));
+	ut_asserteq_str("02:00:11:22:33:77", env_get(name));
+
+	/* An address in the environment is left alone */
+	env_set(name, NULL);
+	env_set(name, "02:00:11:22:33:78");
+	eth_initialize();
+	ut_assert(!device_active(dev));
+	ut_asserteq_str("02:00:11:22:33:78", env_get(name));
+
+	env_set(name, old);
+	env_set(".flags", NULL);
+	free(old);
+
+	return 0;
+}
+DM_TEST(dm_test_probe_on_demand_hwaddr, UT_TESTF_SCAN_FDT);
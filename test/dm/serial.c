@@ -7,6 +7,12 @@
 #include <log.h>
 #include <serial.h>
 #include <dm.h>
+#include <stdio_dev.h>
+#include <asm/serial.h>
+#include <asm/test.h>
+#include <dm/device-internal.h>
+#include <dm/lists.h>
+#include <dm/root.h>
 #include <dm/test.h>
 #include <test/test.h>
 #include <test/ut.h>
@@ -70,3 +76,58 @@ static int dm_test_serial(struct unit_test_state *uts)
 }
 
 DM_TEST(dm_test_serial, UT_TESTF_SCAN_FDT);
+
+#if CONFIG_IS_ENABLED(SERIAL_TX_BUFFER)
+/* Test that buffered output keeps its order and is flushed */
+static int dm_test_serial_tx_buffer(struct unit_test_state *uts)
+{
+	struct sandbox_serial_plat *plat;
+	struct serial_dev_priv *upriv;
+	struct stdio_dev *sdev;
+	struct udevice *dev;
+	char buf[16];
+
+	/* Use a port of its own, not the console */
+	ut_assertok(device_bind_driver(dm_root(), "sandbox_serial", "serial_tx",
+				       &dev));
+	plat = dev_get_plat(dev);
+	plat->colour = -1;
+	ut_assertok(device_probe(dev));
+	upriv = dev_get_uclass_priv(dev);
+	ut_assertnonnull(upriv->tx_buf);
+	sdev = upriv->sdev;
+
+	sandbox_serial_capture_tx(dev, buf, sizeof(buf));
+
+	/* Output that does not fit into the FIFO is kept back... */
+	sandbox_serial_set_tx_full(dev, true);
+	sdev->puts(sdev, "abc");
+	ut_asserteq_str("", buf);
+
+	/* ...and sent ahead of later output */
+	sandbox_serial_set_tx_full(dev, false);
+	sdev->puts(sdev, "de");
+	ut_asserteq_str("abcde", buf);
+
+	/* serial_flush() covers all devices, not only the console */
+	sandbox_serial_set_tx_full(dev, true);
+	sdev->puts(sdev, "fg");
+	ut_asserteq_str("abcde", buf);
+	sandbox_serial_set_tx_full(dev, false);
+	serial_flush();
+	ut_asserteq_str("abcdefg", buf);
+
+	/* Removing the device flushes it too */
+	sandbox_serial_set_tx_full(dev, true);
+	sdev->putc(sdev, 'h');
+	ut_asserteq_str("abcdefg", buf);
+	sandbox_serial_set_tx_full(dev, false);
+	ut_assertok(device_remove(dev, DM_REMOVE_NORMAL));
+	ut_asserteq_str("abcdefgh", buf);
+
+	ut_assertok(device_unbind(dev));
+
+	return 0;
+}
+DM_TEST(dm_test_serial_tx_buffer, UT_TESTF_SCAN_FDT);
+#endif
@@ -817,3 +817,58 @@ static int lib_test_lmb_flags(struct unit_test_state *uts)
 
 DM_TEST(lib_test_lmb_flags,
 	UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
+
+/* Reserve regions out of order and look them up again */
+static int lib_test_lmb_sorted(struct unit_test_state *uts)
+{
+	const phys_addr_t ram = 0x40000000;
+	const phys_size_t ram_size = 0x20000000;
+	struct lmb lmb;
+	long ret;
+
+	lmb_init(&lmb);
+
+	ret = lmb_add(&lmb, ram, ram_size);
+	ut_asserteq(ret, 0);
+
+	ret = lmb_reserve(&lmb, 0x40050000, 0x10000);
+	ut_asserteq(ret, 0);
+	ret = lmb_reserve(&lmb, 0x40010000, 0x10000);
+	ut_asserteq(ret, 0);
+	ret = lmb_reserve(&lmb, 0x40030000, 0x10000);
+	ut_asserteq(ret, 0);
+	ASSERT_LMB(&lmb, ram, ram_size, 3, 0x40010000, 0x10000,
+		   0x40030000, 0x10000, 0x40050000, 0x10000);
+
+	/* adjacent to the first region but overlapping the second one */
+	ret = lmb_reserve(&lmb, 0x40020000, 0x18000);
+	ut_asserteq(ret, -2);
+	ASSERT_LMB(&lmb, ram, ram_size, 3, 0x40010000, 0x10000,
+		   0x40030000, 0x10000, 0x40050000, 0x10000);
+
+	ut_asserteq(0, lmb_is_reserved(&lmb, 0x4000ffff));
+	ut_asserteq(1, lmb_is_reserved(&lmb, 0x40010000));
+	ut_asserteq(1, lmb_is_reserved(&lmb, 0x4003ffff));
+	ut_asserteq(0, lmb_is_reserved(&lmb, 0x40040000));
+	ut_asserteq(0x10000, lmb_get_free_size(&lmb, 0x40040000));
+	ut_asserteq(0, lmb_get_free_size(&lmb, 0x40050000));
+
+	/* fill the gaps, which merges everything into one region */
+	ret = lmb_reserve(&lmb, 0x40040000, 0x10000);
+	ut_asserteq(ret, 2);
+	ret = lmb_reserve(&lmb, 0x40020000, 0x10000);
+	ut_asserteq(ret, 2);
+	ASSERT_LMB(&lmb, ram, ram_size, 1, 0x40010000, 0x50000,
+		   0, 0, 0, 0);
+
+	/* split it again */
+	ret = lmb_free(&lmb, 0x40030000, 0x10000);
+	ut_asserteq(ret, 0);
+	ASSERT_LMB(&lmb, ram, ram_size, 2, 0x40010000, 0x20000,
+		   0x40040000, 0x20000, 0, 0);
+
+	return 0;
+}
+
+DM_TEST(lib_test_lmb_sorted,
+	UT_TESTF_SCAN_PDATA | UT_TESTF_SCAN_FDT);
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for malloc() and free() of many small blocks
+ */
+
+#include <common.h>
+#include <malloc.h>
+#include <time.h>
+#include <test/lib.h>
+#include <test/test.h>
+#include <test/ut.h>
+
+#define MALLOC_TEST_COUNT	1000
+#define MALLOC_TEST_ROUNDS	100
+
+static size_t malloc_test_size(int i)
+{
+	return 1 + (i * 37) % 600;
+}
+
+/* Allocate and free many small blocks, as filesystems and USB do */
+static int lib_test_malloc_small(struct unit_test_state *uts)
+{
+	void **ptrs;
+	ulong start, time;
+	int round, i;
+
+	start = ut_check_free();
+	ptrs = calloc(MALLOC_TEST_COUNT, sizeof(*ptrs));
+	ut_assertnonnull(ptrs);
+
+	time = timer_get_us();
+	for (round = 0; round < MALLOC_TEST_ROUNDS; round++) {
+		for (i = 0; i < MALLOC_TEST_COUNT; i++) {
+			ptrs[i] = malloc(malloc_test_size(i));
+			ut_assertnonnull(ptrs[i]);
+			memset(ptrs[i], (u8)i, malloc_test_size(i));
+		}
+		for (i = 0; i < MALLOC_TEST_COUNT; i++) {
+			u8 *p = ptrs[i];
+
+			/* a block overlapping another would have been changed */
+			ut_asserteq((u8)i, p[0]);
+			ut_asserteq((u8)i, p[malloc_test_size(i) - 1]);
+		}
+		/* free in a different order than allocated */
+		for (i = 0; i < MALLOC_TEST_COUNT; i += 2)
+			free(ptrs[i]);
+		for (i = 1; i < MALLOC_TEST_COUNT; i += 2)
+			free(ptrs[i]);
+	}
+	time = timer_get_us() - time;
+	printf("%d malloc()/free() pairs in %lu us\n",
+	       MALLOC_TEST_COUNT * MALLOC_TEST_ROUNDS, time);
+
+	free(ptrs);
+	ut_assertok(ut_check_delta(start));
+
+	return 0;
+}
+LIB_TEST(lib_test_malloc_small, 0);
@@ -0,0 +1,77 @@
+# SPDX-License-Identifier: GPL-2.0+
+
+import re
+import pytest
+
+"""
+Note: This test relies on boardenv_* containing configuration values to define
+the boot-time budget. Without it, sandbox uses SANDBOX_BUDGET below and other
+boards only check the report itself.
+
+Example:
+
+# Upper limit in microseconds for bootstage records, by name. For marks this
+# is the time since reset, for accumulated records (e.g. device probes with
+# CONFIG_BOOTSTAGE_DM_PROBE) the total time spent.
+env__bootstage_budget = {
+    'board_init_r': 500000,
+    'main_loop': 1000000,
+    'dm_r': 50000,
+}
+"""
+
+# Loose limits for sandbox, which only catch gross regressions since the
+# host may be busy
+SANDBOX_BUDGET = {
+    'board_init_r': 2000000,
+    'main_loop': 5000000,
+    'dm_r': 500000,
+}
+
+RE_RECORD = re.compile(r'^\s*([\d,]+)\s+(?:([\d,]+)\s+)?(\S.*)$')
+
+def parse_report(output):
+    """Parse the output of 'bootstage report'
+
+    Returns:
+        dict: time in microseconds for each record name
+    """
+    records = {}
+    for line in output.splitlines():
+        m = RE_RECORD.match(line)
+        if m:
+            records[m.group(3).strip()] = int(m.group(1).replace(',', ''))
+    return records
+
+@pytest.mark.buildconfigspec('cmd_bootstage')
+def test_bootstage_report(u_boot_console):
+    output = u_boot_console.run_command('bootstage report')
+    assert 'Timer summary in microseconds' in output
+    assert 'Accumulated time:' in output
+
+    records = parse_report(output)
+    assert 'board_init_r' in records
+    assert 'main_loop' in records
+    assert records['main_loop'] >= records['board_init_r']
+
+@pytest.mark.buildconfigspec('cmd_bootstage')
+def test_bootstage_budget(u_boot_console):
+    budget = u_boot_console.config.env.get('env__bootstage_budget')
+    if not budget and u_boot_console.config.buildconfig.get('config_sandbox'):
+        budget = SANDBOX_BUDGET
+    if not budget:
+        pytest.skip('No boot-time budget defined')
+
+    records = parse_report(u_boot_console.run_command('bootstage report'))
+    for name, limit in budget.items():
+        assert name in records, 'No bootstage record for %s' % name
+        assert records[name] <= limit, \
+            '%s took %d us, budget is %d us' % (name, records[name], limit)
+
+@pytest.mark.buildconfigspec('cmd_bootstage')
+@pytest.mark.buildconfigspec('bootstage_cmd')
+@pytest.mark.buildconfigspec('cmd_sleep')
+def test_bootstage_cmd(u_boot_console):
+    u_boot_console.run_command('sleep 0.1')
+    records = parse_report(u_boot_console.run_command('bootstage report'))
+    assert records.get('cmd:sleep', 0) >= 100000